@@ -0,0 +1,184 @@
+/*
+ * Microbenchmarks for vector.h.
+ *
+ *   make -C bench run          # JSON array of results on stdout
+ *   ./bench/bench --max 100000000
+ *
+ * Each case reports ns/op, the number of realloc calls made by the vector
+ * (counted through the VECTOR_REALLOC hook) and the peak RSS of the case.
+ */
+
+#include "bench_common.h"
+
+static void *bench_realloc(void *ptr, size_t size)
+{
+    bench_alloc_count++;
+    return realloc(ptr, size);
+}
+
+#define VECTOR_REALLOC(ptr, size) bench_realloc((ptr), (size))
+#include "vector.h"
+
+typedef struct { uint32_t v[4];  } Elem16;
+typedef struct { uint32_t v[16]; } Elem64;
+
+#define MAKE_u32(i)     ((uint32_t)(i))
+#define MAKE_e16(i)     ((Elem16){ { (uint32_t)(i) } })
+#define MAKE_e64(i)     ((Elem64){ { (uint32_t)(i) } })
+#define KEY_u32(x)      (x)
+#define KEY_e16(x)      ((x).v[0])
+#define KEY_e64(x)      ((x).v[0])
+
+#define EQ_u32(a, b)    ((a) == (b))
+#define EQ_e16(a, b)    ((a).v[0] == (b).v[0])
+#define EQ_e64(a, b)    ((a).v[0] == (b).v[0])
+
+#define BENCH_BEGIN(name, type, n, nops) \
+    BenchCase _case = { "cvector", name, sizeof(type), (n), (nops) }; \
+    bench_alloc_count = 0; \
+    uint64_t _t0 = bench_now_ns();
+
+#define BENCH_END() \
+    bench_report(&_case, bench_now_ns() - _t0, bench_alloc_count);
+
+/* Generates one benchmark function per operation for an element type tag. */
+#define DEFINE_BENCHES(tag, type) \
+static void bench_push_back_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    BENCH_BEGIN("push_back", type, n, n) \
+    for (size_t i = 0; i < n; i++) vector_push_back(v, MAKE_##tag(i)); \
+    BENCH_END() \
+    bench_sink += KEY_##tag(v.data[n - 1]); \
+    vector_destroy(v); \
+} \
+static void bench_push_back_args_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    BENCH_BEGIN("push_back_args", type, n, n / 4) \
+    for (size_t i = 0; i + 4 <= n; i += 4) \
+        vector_push_back_args(v, MAKE_##tag(i), MAKE_##tag(i + 1), MAKE_##tag(i + 2), MAKE_##tag(i + 3)); \
+    BENCH_END() \
+    bench_sink += v.size; \
+    vector_destroy(v); \
+} \
+static void bench_insert_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    BENCH_BEGIN("insert_middle", type, n, n) \
+    for (size_t i = 0; i < n; i++) vector_insert(v, v.size / 2, MAKE_##tag(i)); \
+    BENCH_END() \
+    bench_sink += v.size; \
+    vector_destroy(v); \
+} \
+static void bench_insert_range_##tag(size_t n) \
+{ \
+    type chunk[64]; \
+    for (size_t i = 0; i < 64; i++) chunk[i] = MAKE_##tag(i); \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    BENCH_BEGIN("insert_range_middle_64", type, n, n / 64) \
+    for (size_t i = 0; i + 64 <= n; i += 64) vector_insert_range(v, v.size / 2, chunk, 64); \
+    BENCH_END() \
+    bench_sink += v.size; \
+    vector_destroy(v); \
+} \
+static int cmp_##tag(type a, type b) { return EQ_##tag(a, b); } \
+static void bench_find_custom_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    for (size_t i = 0; i < n; i++) vector_push_back(v, MAKE_##tag(i)); \
+    ptrdiff_t hit = 0; \
+    BENCH_BEGIN("find_custom_miss", type, n, BENCH_FIND_OPS) \
+    for (int r = 0; r < BENCH_FIND_OPS; r++) hit += vector_find_custom(v, MAKE_##tag(n + (size_t)r), cmp_##tag); \
+    BENCH_END() \
+    bench_sink += (uint64_t)hit; \
+    vector_destroy(v); \
+} \
+static void bench_resize_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    BENCH_BEGIN("resize", type, n, n) \
+    vector_resize(v, n, MAKE_##tag(7)); \
+    BENCH_END() \
+    bench_sink += KEY_##tag(v.data[n - 1]); \
+    vector_destroy(v); \
+} \
+static void bench_shrink_to_fit_##tag(size_t n) \
+{ \
+    vector(type) v; \
+    memset(&v, 0, sizeof v); \
+    vector_init(v); \
+    for (size_t i = 0; i < n + n / 3 + 1; i++) vector_push_back(v, MAKE_##tag(i)); \
+    v.size = n; \
+    BENCH_BEGIN("shrink_to_fit", type, n, 1) \
+    vector_shrink_to_fit(v); \
+    BENCH_END() \
+    bench_sink += v.capacity; \
+    vector_destroy(v); \
+}
+
+DEFINE_BENCHES(u32, uint32_t)
+DEFINE_BENCHES(e16, Elem16)
+DEFINE_BENCHES(e64, Elem64)
+
+static void bench_find_u32(size_t n)
+{
+    vector(uint32_t) v;
+    memset(&v, 0, sizeof v);
+    vector_init(v);
+    for (size_t i = 0; i < n; i++) vector_push_back(v, (uint32_t)i);
+    ptrdiff_t hit = 0;
+    BENCH_BEGIN("find_miss", uint32_t, n, BENCH_FIND_OPS)
+    for (int r = 0; r < BENCH_FIND_OPS; r++) hit += vector_find(v, (uint32_t)(n + (size_t)r));
+    BENCH_END()
+    bench_sink += (uint64_t)hit;
+    vector_destroy(v);
+}
+
+typedef struct {
+    void  (*fn)(size_t);
+    size_t max_count;   /* 0 = no cap */
+} BenchEntry;
+
+#define BENCH_ENTRIES(tag) \
+    { bench_push_back_##tag,      0 }, \
+    { bench_push_back_args_##tag, 0 }, \
+    { bench_insert_##tag,         BENCH_INSERT_MAX }, \
+    { bench_insert_range_##tag,   BENCH_INSERT_MAX * 10 }, \
+    { bench_find_custom_##tag,    0 }, \
+    { bench_resize_##tag,         0 }, \
+    { bench_shrink_to_fit_##tag,  0 }
+
+int main(int argc, char **argv)
+{
+    static const BenchEntry entries[] = {
+        BENCH_ENTRIES(u32),
+        { bench_find_u32, 0 },
+        BENCH_ENTRIES(e16),
+        BENCH_ENTRIES(e64),
+    };
+    size_t max = bench_parse_max(argc, argv);
+
+    printf("[\n");
+    for (size_t e = 0; e < sizeof(entries) / sizeof(entries[0]); e++) {
+        for (size_t n = 10; n <= max; n *= 10) {
+            if (entries[e].max_count && n > entries[e].max_count) break;
+            if (bench_run_isolated(entries[e].fn, n) != 0)
+                fprintf(stderr, "bench case %zu (n=%zu) failed\n", e, n);
+        }
+    }
+    printf("\n]\n");
+    return 0;
+}
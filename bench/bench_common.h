@@ -0,0 +1,99 @@
+/*!
+    @file bench_common.h header file
+    @brief  timing, allocation counting and JSON reporting shared by the vector.h
+            and std::vector microbenchmarks.
+
+    Every case runs in a forked child so that `peak_rss_kb` (getrusage) belongs
+    to that case alone. Each child prints one JSON object to stdout and `main`
+    wraps them into a single JSON array.
+*/
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/* Incremented by the allocation hooks of each benchmark binary. */
+static size_t bench_alloc_count;
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline long bench_peak_rss_kb(void)
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+/* Keeps the optimizer from discarding benchmark results. */
+static volatile uint64_t bench_sink;
+
+/* Records printed so far; read by the child to place the JSON array separator. */
+static size_t bench_records;
+
+typedef struct {
+    const char *impl;       /* "cvector" or "std::vector" */
+    const char *op;
+    size_t      elem_size;
+    size_t      count;      /* elements in the vector */
+    size_t      ops;        /* operations timed */
+} BenchCase;
+
+static inline void bench_report(const BenchCase *c, uint64_t ns, size_t allocs)
+{
+    printf("%s{\"impl\":\"%s\",\"op\":\"%s\",\"elem_size\":%zu,\"count\":%zu,\"ops\":%zu,"
+           "\"ns_total\":%llu,\"ns_per_op\":%.3f,\"allocations\":%zu,\"peak_rss_kb\":%ld}",
+           bench_records ? ",\n" : "", c->impl, c->op, c->elem_size, c->count, c->ops,
+           (unsigned long long)ns, c->ops ? (double)ns / (double)c->ops : 0.0,
+           allocs, bench_peak_rss_kb());
+    fflush(stdout);
+}
+
+/* Runs fn(count) in a child process; returns 0 on success. */
+static inline int bench_run_isolated(void (*fn)(size_t), size_t count)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        bench_alloc_count = 0;
+        fn(count);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+    bench_records++;
+    return 0;
+}
+
+/* Parses "--max N" and "--quick"; returns the largest element count to run. */
+static inline size_t bench_parse_max(int argc, char **argv)
+{
+    size_t max = 10000000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) max = (size_t)strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--quick") == 0) max = 100000;
+    }
+    return max;
+}
+
+/* Middle inserts are O(n^2); cap their element count so the suite finishes. */
+#define BENCH_INSERT_MAX  100000
+/* Linear scans: each find/count walks the whole vector, so time a fixed number of lookups. */
+#define BENCH_FIND_OPS    16
+
+#endif /* BENCH_COMMON_H */
@@ -0,0 +1,161 @@
+/*
+ * std::vector counterpart of bench.c, reporting the same JSON fields so the
+ * two result sets can be compared case by case.
+ */
+
+#include "bench_common.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+void *operator new(std::size_t size)
+{
+    bench_alloc_count++;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+struct Elem16 { uint32_t v[4];  };
+struct Elem64 { uint32_t v[16]; };
+
+template <typename T> static T make(size_t i) { T e = {}; e.v[0] = (uint32_t)i; return e; }
+template <> uint32_t make<uint32_t>(size_t i) { return (uint32_t)i; }
+
+template <typename T> static uint32_t key(const T &e) { return e.v[0]; }
+template <> uint32_t key<uint32_t>(const uint32_t &e) { return e; }
+
+#define BENCH_BEGIN(name, T, n, nops) \
+    BenchCase _case = { "std::vector", name, sizeof(T), (n), (nops) }; \
+    bench_alloc_count = 0; \
+    uint64_t _t0 = bench_now_ns();
+
+#define BENCH_END() \
+    bench_report(&_case, bench_now_ns() - _t0, bench_alloc_count);
+
+template <typename T> static void bench_push_back(size_t n)
+{
+    std::vector<T> v;
+    BENCH_BEGIN("push_back", T, n, n)
+    for (size_t i = 0; i < n; i++) v.push_back(make<T>(i));
+    BENCH_END()
+    bench_sink += key(v[n - 1]);
+}
+
+template <typename T> static void bench_push_back_args(size_t n)
+{
+    std::vector<T> v;
+    BENCH_BEGIN("push_back_args", T, n, n / 4)
+    for (size_t i = 0; i + 4 <= n; i += 4)
+        v.insert(v.end(), { make<T>(i), make<T>(i + 1), make<T>(i + 2), make<T>(i + 3) });
+    BENCH_END()
+    bench_sink += v.size();
+}
+
+template <typename T> static void bench_insert(size_t n)
+{
+    std::vector<T> v;
+    BENCH_BEGIN("insert_middle", T, n, n)
+    for (size_t i = 0; i < n; i++) v.insert(v.begin() + (ptrdiff_t)(v.size() / 2), make<T>(i));
+    BENCH_END()
+    bench_sink += v.size();
+}
+
+template <typename T> static void bench_insert_range(size_t n)
+{
+    T chunk[64];
+    for (size_t i = 0; i < 64; i++) chunk[i] = make<T>(i);
+    std::vector<T> v;
+    BENCH_BEGIN("insert_range_middle_64", T, n, n / 64)
+    for (size_t i = 0; i + 64 <= n; i += 64) v.insert(v.begin() + (ptrdiff_t)(v.size() / 2), chunk, chunk + 64);
+    BENCH_END()
+    bench_sink += v.size();
+}
+
+template <typename T> static void bench_find_custom(size_t n)
+{
+    std::vector<T> v;
+    for (size_t i = 0; i < n; i++) v.push_back(make<T>(i));
+    ptrdiff_t hit = 0;
+    BENCH_BEGIN("find_custom_miss", T, n, BENCH_FIND_OPS)
+    for (int r = 0; r < BENCH_FIND_OPS; r++) {
+        uint32_t k = (uint32_t)(n + (size_t)r);
+        auto it = std::find_if(v.begin(), v.end(), [k](const T &e) { return key(e) == k; });
+        hit += it == v.end() ? -1 : it - v.begin();
+    }
+    BENCH_END()
+    bench_sink += (uint64_t)hit;
+}
+
+static void bench_find_u32(size_t n)
+{
+    std::vector<uint32_t> v;
+    for (size_t i = 0; i < n; i++) v.push_back((uint32_t)i);
+    ptrdiff_t hit = 0;
+    BENCH_BEGIN("find_miss", uint32_t, n, BENCH_FIND_OPS)
+    for (int r = 0; r < BENCH_FIND_OPS; r++) {
+        auto it = std::find(v.begin(), v.end(), (uint32_t)(n + (size_t)r));
+        hit += it == v.end() ? -1 : it - v.begin();
+    }
+    BENCH_END()
+    bench_sink += (uint64_t)hit;
+}
+
+template <typename T> static void bench_resize(size_t n)
+{
+    std::vector<T> v;
+    BENCH_BEGIN("resize", T, n, n)
+    v.resize(n, make<T>(7));
+    BENCH_END()
+    bench_sink += key(v[n - 1]);
+}
+
+template <typename T> static void bench_shrink_to_fit(size_t n)
+{
+    std::vector<T> v;
+    for (size_t i = 0; i < n + n / 3 + 1; i++) v.push_back(make<T>(i));
+    v.resize(n);
+    BENCH_BEGIN("shrink_to_fit", T, n, 1)
+    v.shrink_to_fit();
+    BENCH_END()
+    bench_sink += v.capacity();
+}
+
+struct BenchEntry {
+    void  (*fn)(size_t);
+    size_t max_count;   /* 0 = no cap */
+};
+
+#define BENCH_ENTRIES(T) \
+    { bench_push_back<T>,      0 }, \
+    { bench_push_back_args<T>, 0 }, \
+    { bench_insert<T>,         BENCH_INSERT_MAX }, \
+    { bench_insert_range<T>,   BENCH_INSERT_MAX * 10 }, \
+    { bench_find_custom<T>,    0 }, \
+    { bench_resize<T>,         0 }, \
+    { bench_shrink_to_fit<T>,  0 }
+
+int main(int argc, char **argv)
+{
+    static const BenchEntry entries[] = {
+        BENCH_ENTRIES(uint32_t),
+        { bench_find_u32, 0 },
+        BENCH_ENTRIES(Elem16),
+        BENCH_ENTRIES(Elem64),
+    };
+    size_t max = bench_parse_max(argc, argv);
+
+    printf("[\n");
+    for (size_t e = 0; e < sizeof(entries) / sizeof(entries[0]); e++) {
+        for (size_t n = 10; n <= max; n *= 10) {
+            if (entries[e].max_count && n > entries[e].max_count) break;
+            if (bench_run_isolated(entries[e].fn, n) != 0)
+                fprintf(stderr, "bench case %zu (n=%zu) failed\n", e, n);
+        }
+    }
+    printf("\n]\n");
+    return 0;
+}
@@ -33,6 +33,7 @@
 
 #ifdef __cplusplus
 /* C++ Compiler Configuration */
+    #include <cstddef>
     #include <cstdio>
     #include <cstdlib>
     #include <cstdint>
@@ -49,6 +50,7 @@
     #define NULL_PTR nullptr
 #else 
 /* Standard C Compiler Configuration */
+    #include <stddef.h>
     #include <stdio.h>
     #include <stdlib.h>
     #include <stdint.h>
@@ -83,6 +85,52 @@
     #define VECTOR_UNREACHABLE()    ((void)0)
 #endif
 
+/**
+ * @brief Keeps a function out of line, in the cold text section, without unused-function warnings.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define VECTOR_NOINLINE         __attribute__((noinline))
+    #define VECTOR_COLD             __attribute__((cold))
+    #define VECTOR_MAYBE_UNUSED     __attribute__((unused))
+#elif defined(_MSC_VER)
+    #define VECTOR_NOINLINE         __declspec(noinline)
+    #define VECTOR_COLD
+    #define VECTOR_MAYBE_UNUSED
+#else
+    #define VECTOR_NOINLINE
+    #define VECTOR_COLD
+    #define VECTOR_MAYBE_UNUSED
+#endif
+
+/**
+ * @brief Alignment specifier usable in both C11 and C++11 declarations,
+ *        and the cache-line size used to keep per-thread data apart.
+ */
+#ifdef __cplusplus
+    #define VECTOR_ALIGNAS(n)       alignas(n)
+#else
+    #define VECTOR_ALIGNAS(n)       _Alignas(n)
+#endif
+#ifndef VECTOR_CACHE_LINE
+    #define VECTOR_CACHE_LINE       64
+#endif
+
+/**
+ * @brief Bit-scan helpers on 64-bit masks. VECTOR_CTZ64 / VECTOR_CLZ64 are undefined for 0.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define VECTOR_CTZ64(x)         ((unsigned)__builtin_ctzll((unsigned long long)(x)))
+    #define VECTOR_CLZ64(x)         ((unsigned)__builtin_clzll((unsigned long long)(x)))
+    #define VECTOR_POPCOUNT64(x)    ((unsigned)__builtin_popcountll((unsigned long long)(x)))
+#else
+    static inline unsigned private_vector_ctz64(uint64_t x) { unsigned n = 0; while (!(x & 1)) { x >>= 1; n++; } return n; }
+    static inline unsigned private_vector_clz64(uint64_t x) { unsigned n = 0; while (!(x >> 63)) { x <<= 1; n++; } return n; }
+    static inline unsigned private_vector_popcount64(uint64_t x) { unsigned n = 0; while (x) { x &= x - 1; n++; } return n; }
+    #define VECTOR_CTZ64(x)         private_vector_ctz64((uint64_t)(x))
+    #define VECTOR_CLZ64(x)         private_vector_clz64((uint64_t)(x))
+    #define VECTOR_POPCOUNT64(x)    private_vector_popcount64((uint64_t)(x))
+#endif
+
 /**
  * @section Compile-time Type Safety
  * -------------------------------------------------------------------------
@@ -126,6 +174,99 @@
 #endif
 
 
+/**
+ * @section Build Configuration
+ * -------------------------------------------------------------------------
+ * VECTOR_UNCHECKED (or VECTOR_NDEBUG) builds the release flavour of the library:
+ * - the `magic` field disappears from every vector, together with every
+ *   init/destroy tracking check that reads it;
+ * - misuse checks (out-of-range positions, pop on empty, NULL source arrays)
+ *   are compiled out and `vector_at`/`vector_back`/`vector_front` become plain indexing;
+ * - diagnostics are dropped unless VECTOR_ON_ERROR is defined by the user.
+ * Allocation failures are still detected and reported through VECTOR_ON_ERROR.
+ *
+ * VECTOR_ON_ERROR(msg, file, line) receives every diagnostic. Define it before
+ * including this header to route errors to your own handler; it must be usable
+ * as an expression. The default prints "msg at file:line" to stderr.
+ *
+ * @warning Translation units that share vector types must agree on VECTOR_UNCHECKED,
+ *          because it changes the struct layout.
+ */
+#if defined(VECTOR_NDEBUG) && !defined(VECTOR_UNCHECKED)
+    #define VECTOR_UNCHECKED
+#endif
+
+#ifndef VECTOR_ON_ERROR
+    #ifdef VECTOR_UNCHECKED
+        #define VECTOR_ON_ERROR(msg, file, line) ((void)0)
+        #define PRIVATE_VECTOR_SILENT
+    #else
+        #define VECTOR_ON_ERROR(msg, file, line) \
+            ((void)CLIB_PREFIX fprintf(stderr, "%s at %s:%d\n", (msg), (file), (line)))
+    #endif
+#endif
+
+/**
+ * @brief Linkage of the out-of-line cold paths (growth, diagnostics).
+ *        By default every translation unit keeps its own noinline copy. To compile them once,
+ *        build every translation unit with VECTOR_EXTERN and define VECTOR_IMPLEMENTATION
+ *        in exactly one of them before including this header.
+ * @note  With VECTOR_EXTERN, diagnostics go through the VECTOR_ON_ERROR of the
+ *        VECTOR_IMPLEMENTATION translation unit.
+ */
+#if defined(VECTOR_IMPLEMENTATION)
+    #define VECTOR_COLD_API         VECTOR_NOINLINE VECTOR_COLD
+#elif defined(VECTOR_EXTERN)
+    #define VECTOR_COLD_API         extern VECTOR_COLD
+#else
+    #define VECTOR_COLD_API         static VECTOR_NOINLINE VECTOR_COLD VECTOR_MAYBE_UNUSED
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+VECTOR_COLD_API void private_vector_report(const char *msg, const char *file, int line);
+VECTOR_COLD_API int  private_vector_grow_base(void *vec_ptr, size_t elem_size, size_t needed,
+                                              const char *msg, const char *file, int line);
+VECTOR_COLD_API int  private_vector_reserve_base(void *vec_ptr, size_t elem_size, size_t new_capacity, int exact,
+                                                 const char *msg, const char *file, int line);
+VECTOR_COLD_API void private_vector_shrink_base(void *vec_ptr, size_t elem_size, const char *file, int line);
+#ifdef __cplusplus
+}
+#endif
+
+/* !! PRIVATE !! — Reports a diagnostic out of line; nothing at all when diagnostics are compiled out */
+#ifdef PRIVATE_VECTOR_SILENT
+    #define private_vector_fail(msg, file, line)    ((void)0)
+#else
+    #define private_vector_fail(msg, file, line)    private_vector_report((msg), (file), (line))
+#endif
+
+/**
+ * @brief Debug-only contract check used by the *_unchecked fast paths.
+ *        Aborts with a diagnostic on failure; compiles to nothing under VECTOR_UNCHECKED.
+ */
+#ifdef VECTOR_UNCHECKED
+    #define VECTOR_ASSERT(cond, msg)            ((void)0)
+#else
+    #define VECTOR_ASSERT(cond, msg) \
+        (LIKELY(cond) ? (void)0 : (private_vector_fail((msg), __FILE__, __LINE__), CLIB_PREFIX abort()))
+#endif
+
+#ifdef VECTOR_UNCHECKED
+    #define VECTOR_CHECK(cond)                  0
+    #define VECTOR_MAGIC_FIELD
+    #define vector_is_valid(v)                  1
+    #define private_vector_has_magic(v, m)      0
+    #define private_vector_set_magic(v, m)      ((void)0)
+#else
+    #define VECTOR_CHECK(cond)                  UNLIKELY(cond)
+    #define VECTOR_MAGIC_FIELD                  uint32_t magic;
+    #define vector_is_valid(v)                  ((v).magic == VECTOR_MAGIC_INIT)
+    #define private_vector_has_magic(v, m)      ((v).magic == (m))
+    #define private_vector_set_magic(v, m)      ((void)((v).magic = (m)))
+#endif
+
 /**
 * @section Vector Core Metadata
 * -------------------------------------------------------------------------
@@ -135,31 +276,137 @@
 #define VECTOR_MAGIC_INIT      0xDEADBEEF
 #define VECTOR_MAGIC_DESTROYED 0xFEEDFACE
 
+/**
+ * @section Allocator Hook
+ * -------------------------------------------------------------------------
+ * Every growth, shrink and destroy path goes through a VectorAllocator.
+ * A vector whose `allocator` is NULL uses VECTOR_REALLOC / VECTOR_FREE,
+ * which default to the C library and may be overridden per translation unit
+ * by defining them before including this header.
+ *
+ * realloc_fn receives the old and new block sizes in bytes so that arena and
+ * pool allocators do not need to keep per-block headers. free_fn receives the
+ * size of the block being released.
+ */
+#ifndef VECTOR_REALLOC
+    #define VECTOR_REALLOC(ptr, new_size) CLIB_PREFIX realloc((ptr), (new_size))
+#endif
+#ifndef VECTOR_FREE
+    #define VECTOR_FREE(ptr)              CLIB_PREFIX free((ptr))
+#endif
+
+/**
+ * @section Growth Policy
+ * -------------------------------------------------------------------------
+ * Every growth site asks the vector's growth policy for the next capacity.
+ * The default policy is picked at compile time with the VECTOR_GROWTH_* knobs
+ * below; a per-vector (or per-type, via a shared allocator) policy can be set
+ * through VectorAllocator::growth.
+ *
+ * - VECTOR_GROW_DOUBLE:             cap * 2 (the historical behaviour).
+ * - VECTOR_GROW_1_5X:               cap + cap / 2.
+ * - VECTOR_GROW_PAGE:               cap + cap / 2, byte size rounded up to whole pages.
+ * - VECTOR_GROW_DOUBLE_THEN_LINEAR: doubles below `threshold` bytes, then adds `chunk` bytes.
+ * - VECTOR_GROW_CUSTOM:             calls `custom(policy, cap, needed, elem_size)`.
+ *
+ * After the step, `max_step` (bytes, 0 = unlimited) caps the increment,
+ * `min_capacity` is applied, and the result never falls below `needed`.
+ * A nonzero `granule` (bytes) then rounds the byte capacity up to a multiple of
+ * it; unlike the growth step, it is also applied by vector_reserve_exact and
+ * vector_shrink_to_fit, so it holds for every capacity the vector reaches.
+ */
+typedef enum {
+    VECTOR_GROW_DOUBLE = 0,
+    VECTOR_GROW_1_5X,
+    VECTOR_GROW_PAGE,
+    VECTOR_GROW_DOUBLE_THEN_LINEAR,
+    VECTOR_GROW_CUSTOM
+} VectorGrowthKind;
+
+typedef struct VectorGrowthPolicy {
+    VectorGrowthKind kind;
+    size_t           min_capacity;   /* elements */
+    size_t           max_step;       /* bytes, 0 = unlimited */
+    size_t           threshold;      /* bytes, DOUBLE_THEN_LINEAR switch point */
+    size_t           chunk;          /* bytes, DOUBLE_THEN_LINEAR linear step */
+    size_t         (*custom)(const struct VectorGrowthPolicy *policy, size_t cap, size_t needed, size_t elem_size);
+    size_t           granule;        /* bytes, 0 = none; capacity is padded to a multiple of it */
+} VectorGrowthPolicy;
+
+#ifndef VECTOR_GROWTH_KIND
+    #define VECTOR_GROWTH_KIND         VECTOR_GROW_DOUBLE
+#endif
+#ifndef VECTOR_GROWTH_MIN_CAPACITY
+    #define VECTOR_GROWTH_MIN_CAPACITY 4
+#endif
+#ifndef VECTOR_GROWTH_MAX_STEP
+    #define VECTOR_GROWTH_MAX_STEP     0
+#endif
+#ifndef VECTOR_GROWTH_THRESHOLD
+    #define VECTOR_GROWTH_THRESHOLD    ((size_t)64 << 20)   /* 64 MiB */
+#endif
+#ifndef VECTOR_GROWTH_CHUNK
+    #define VECTOR_GROWTH_CHUNK        ((size_t)16 << 20)   /* 16 MiB */
+#endif
+#ifndef VECTOR_PAGE_SIZE
+    #define VECTOR_PAGE_SIZE           ((size_t)4096)
+#endif
+
+/**
+ * @brief Initializer for a VectorGrowthPolicy of the given kind using the compile-time knobs.
+ * @example
+ *   static const VectorGrowthPolicy rows_growth = VECTOR_GROWTH_POLICY(VECTOR_GROW_1_5X);
+ */
+#define VECTOR_GROWTH_POLICY(kind) \
+    { (kind), VECTOR_GROWTH_MIN_CAPACITY, VECTOR_GROWTH_MAX_STEP, \
+      VECTOR_GROWTH_THRESHOLD, VECTOR_GROWTH_CHUNK, NULL_PTR, 0 }
+
+typedef struct VectorAllocator {
+    void *(*realloc_fn)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void  (*free_fn)(void *ctx, void *ptr, size_t size);
+    void   *ctx;
+    const VectorGrowthPolicy *growth;   /* NULL = compile-time default policy */
+} VectorAllocator;
+
+/**
+ * @brief Initializer for an allocator that keeps the default heap but overrides the growth policy.
+ * @example
+ *   static const VectorGrowthPolicy big = VECTOR_GROWTH_POLICY(VECTOR_GROW_DOUBLE_THEN_LINEAR);
+ *   static const VectorAllocator    big_heap = VECTOR_HEAP_ALLOCATOR(&big);
+ *   vector_init_with_allocator(rows, &big_heap);
+ */
+#define VECTOR_HEAP_ALLOCATOR(growth_policy) { NULL_PTR, NULL_PTR, NULL_PTR, (growth_policy) }
+
 typedef struct {
-    void    *data;
-    size_t   size;
-    size_t   capacity;
-    uint32_t magic;
+    void                  *data;
+    size_t                 size;
+    size_t                 capacity;
+    const VectorAllocator *allocator;
+    VECTOR_MAGIC_FIELD
 } VectorBase;
 
 /**
  * @brief Declares an anonymous vector struct for the given type.
  * @note  Use `vector(type)` as the variable type.
+ * @note  The field layout matches VectorBase; the type-erased helpers rely on it.
  *
  * @example
  *   vector(int) nums;
  *   vector_init(nums);
  */
+#define VECTOR_FIELDS(type) \
+        type                  *data; \
+        size_t                 size; \
+        size_t                 capacity; \
+        const VectorAllocator *allocator; \
+        VECTOR_MAGIC_FIELD
+
 #define VECTOR_DEFINE(type) \
     struct { \
-        type     *data; \
-        size_t    size; \
-        size_t    capacity; \
-        uint32_t  magic; \
+        VECTOR_FIELDS(type) \
     }
 
 #define vector(type)        VECTOR_DEFINE(type)
-#define vector_is_valid(v)  ((v).magic == VECTOR_MAGIC_INIT)
 
 /** 
  * Initializes the vector structure. Includes a safety check against 
@@ -169,18 +416,605 @@ typedef struct {
  */
 #define vector_init(vec) do { \
     VECTOR_ASSERT_TRIVIAL(vec); \
-    if ((vec).magic == VECTOR_MAGIC_INIT) { \
-        CLIB_PREFIX fprintf(stderr, "[!] Warning: vector already initialized at %s:%d\n", __FILE__, __LINE__); \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
         break; \
     } \
     (vec).data     = NULL_PTR; \
     (vec).size     = 0; \
-    (vec).capacity = 0; \
-    (vec).magic    = VECTOR_MAGIC_INIT; \
+    (vec).capacity  = 0; \
+    (vec).allocator = NULL_PTR; \
+    private_vector_set_magic(vec, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Initializes the vector and attaches a custom allocator to it.
+ * All later growth, shrink and destroy calls on this vector go through `alloc`.
+ * @param vec   The vector structure to initialize.
+ * @param alloc Pointer to a VectorAllocator that outlives the vector (NULL = default heap).
+ */
+#define vector_init_with_allocator(vec, alloc) do { \
+    VECTOR_ASSERT_TRIVIAL(vec); \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    (vec).data      = NULL_PTR; \
+    (vec).size      = 0; \
+    (vec).capacity  = 0; \
+    (vec).allocator = (alloc); \
+    private_vector_set_magic(vec, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_realloc
+(
+    const VectorAllocator *alloc, void *ptr,
+    size_t old_size, size_t new_size
+)
+
+{
+    if (alloc == NULL_PTR || alloc->realloc_fn == NULL_PTR) return VECTOR_REALLOC(ptr, new_size);
+    return alloc->realloc_fn(alloc->ctx, ptr, old_size, new_size);
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_free(const VectorAllocator *alloc, void *ptr, size_t size)
+{
+    if (alloc == NULL_PTR || alloc->free_fn == NULL_PTR) { VECTOR_FREE(ptr); return; }
+    alloc->free_fn(alloc->ctx, ptr, size);
+}
+
+/* !! PRIVATE !! — Returns the growth policy in effect for a vector's allocator */
+static inline const VectorGrowthPolicy *private_vector_growth(const VectorAllocator *alloc)
+{
+    static const VectorGrowthPolicy default_policy = VECTOR_GROWTH_POLICY(VECTOR_GROWTH_KIND);
+    return (alloc != NULL_PTR && alloc->growth != NULL_PTR) ? alloc->growth : &default_policy;
+}
+
+/* !! PRIVATE !! — Rounds cap up so that cap * elem_size is a multiple of the policy granule */
+static inline size_t private_vector_pad_capacity(const VectorGrowthPolicy *p, size_t cap, size_t elem_size)
+{
+    if (p->granule == 0) return cap;
+    size_t a = p->granule, b = elem_size;
+    while (b != 0) { size_t t = a % b; a = b; b = t; }
+    size_t step = p->granule / a;    /* elements per granule-aligned run */
+    size_t padded = (cap + step - 1) / step * step;
+    return padded < cap ? cap : padded;
+}
+
+/* !! PRIVATE !! — Smallest capacity >= needed allowed by the policy (min capacity, page rounding, granule) */
+static inline size_t private_vector_fit_capacity(const VectorGrowthPolicy *p, size_t needed, size_t elem_size)
+{
+    size_t nc = needed < p->min_capacity ? p->min_capacity : needed;
+    if (p->kind == VECTOR_GROW_PAGE && nc <= (SIZE_MAX - VECTOR_PAGE_SIZE) / elem_size) {
+        size_t bytes = (nc * elem_size + VECTOR_PAGE_SIZE - 1) & ~(VECTOR_PAGE_SIZE - 1);
+        nc = bytes / elem_size;
+    }
+    return private_vector_pad_capacity(p, nc, elem_size);
+}
+
+/* !! PRIVATE !! — Next capacity when a vector of capacity `cap` must hold `needed` elements */
+static inline size_t private_vector_next_capacity
+(
+    const VectorGrowthPolicy *p,
+    size_t cap, size_t needed, size_t elem_size
+)
+
+{
+    size_t nc;
+    switch (p->kind) {
+        case VECTOR_GROW_1_5X:
+        case VECTOR_GROW_PAGE:
+            nc = cap + (cap >> 1);
+            break;
+        case VECTOR_GROW_DOUBLE_THEN_LINEAR:
+            nc = cap * elem_size < p->threshold ? cap << 1 : cap + p->chunk / elem_size;
+            break;
+        case VECTOR_GROW_CUSTOM:
+            nc = p->custom(p, cap, needed, elem_size);
+            break;
+        case VECTOR_GROW_DOUBLE:
+        default:
+            nc = cap << 1;
+            break;
+    }
+    if (nc < cap) nc = needed;  /* overflow */
+    if (p->max_step != 0 && (nc - cap) > p->max_step / elem_size) {
+        size_t step = p->max_step / elem_size;
+        nc = cap + (step ? step : 1);
+    }
+    if (nc < needed) nc = needed;
+    return private_vector_fit_capacity(p, nc, elem_size);
+}
+
+/* !! PRIVATE !! — Capacity `cap` padded to the granule of (vec)'s growth policy */
+#define private_vector_padded_capacity(vec, cap) \
+    private_vector_pad_capacity(private_vector_growth((vec).allocator), (size_t)(cap), sizeof(*(vec).data))
+
+/* !! PRIVATE !! — Growth-policy capacity for (vec) to hold `needed` elements */
+#define private_vector_grow_capacity(vec, needed) \
+    private_vector_next_capacity(private_vector_growth((vec).allocator), \
+        (vec).capacity, (size_t)(needed), sizeof(*(vec).data))
+
+/**
+ * @section Growth Statistics
+ * -------------------------------------------------------------------------
+ * Building with VECTOR_STATS records every reallocation made by a growth or
+ * shrink path against the call site (`__FILE__`/`__LINE__`) of the vector macro
+ * that triggered it:
+ * - reallocs:      number of reallocations issued from the site;
+ * - bytes_copied:  bytes the allocator may have had to move (the smaller of the
+ *                  old and new block; an upper bound, realloc can extend in place);
+ * - peak_capacity: largest block requested from the site, in bytes;
+ * - peak_waste:    largest (capacity - size) in bytes left right after a growth.
+ *
+ * `vector_stats_dump(stream)` prints one line per site, most bytes copied first;
+ * the top entries are where a `vector_reserve` pays off. `vector_stats_reset()`
+ * clears the table. Without VECTOR_STATS both are no-ops and nothing is recorded.
+ *
+ * @note The table holds VECTOR_STATS_MAX_SITES sites and is not thread-safe.
+ *       With GCC/Clang it is shared by every translation unit; with other
+ *       compilers each translation unit keeps its own.
+ */
+#ifdef VECTOR_STATS
+
+#ifndef VECTOR_STATS_MAX_SITES
+    #define VECTOR_STATS_MAX_SITES 1024
+#endif
+
+typedef struct {
+    const char *file;
+    int         line;
+    size_t      reallocs;
+    size_t      bytes_copied;
+    size_t      peak_capacity;
+    size_t      peak_waste;
+} VectorStatsSite;
+
+typedef struct {
+    VectorStatsSite sites[VECTOR_STATS_MAX_SITES];
+    size_t          used;
+    size_t          dropped;    /* reallocations from sites that did not fit */
+} VectorStatsTable;
+
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((weak)) VectorStatsTable private_vector_stats_table;
+#else
+    static VectorStatsTable private_vector_stats_table;
+#endif
+
+/* !! PRIVATE !! — Finds or creates the entry for a call site; NULL when the table is full */
+static inline VectorStatsSite *private_vector_stats_site(const char *file, int line)
+{
+    VectorStatsTable *t = &private_vector_stats_table;
+    size_t h = ((size_t)(unsigned)line * 2654435761u) % VECTOR_STATS_MAX_SITES;
+    for (size_t probe = 0; probe < VECTOR_STATS_MAX_SITES; probe++) {
+        VectorStatsSite *s = &t->sites[(h + probe) % VECTOR_STATS_MAX_SITES];
+        if (s->file == NULL_PTR) {
+            s->file = file;
+            s->line = line;
+            t->used++;
+            return s;
+        }
+        if (s->line == line && (s->file == file || strcmp(s->file, file) == 0)) return s;
+    }
+    return NULL_PTR;
+}
+
+/* !! PRIVATE !! — Records one reallocation of a block from old_cap to new_cap elements */
+static inline void private_vector_stats_record
+(
+    const char *file, int line, size_t elem_size,
+    const void *old_data, size_t old_cap, size_t new_cap, size_t size
+)
+
+{
+    VectorStatsSite *s = private_vector_stats_site(file, line);
+    if (s == NULL_PTR) { private_vector_stats_table.dropped++; return; }
+    size_t kept = old_cap < new_cap ? old_cap : new_cap;
+    s->reallocs++;
+    if (old_data != NULL_PTR) s->bytes_copied += kept * elem_size;
+    if (new_cap * elem_size > s->peak_capacity) s->peak_capacity = new_cap * elem_size;
+    if (new_cap > size && (new_cap - size) * elem_size > s->peak_waste)
+        s->peak_waste = (new_cap - size) * elem_size;
+}
+
+/* !! PRIVATE !! — qsort order for vector_stats_dump: most bytes copied, then most reallocs */
+static inline int private_vector_stats_cmp(const void *a, const void *b)
+{
+    const VectorStatsSite *x = *(const VectorStatsSite *const *)a;
+    const VectorStatsSite *y = *(const VectorStatsSite *const *)b;
+    if (x->bytes_copied != y->bytes_copied) return x->bytes_copied < y->bytes_copied ? 1 : -1;
+    if (x->reallocs != y->reallocs)         return x->reallocs < y->reallocs ? 1 : -1;
+    return 0;
+}
+
+/**
+ * Prints the per-call-site growth report, sorted by bytes copied.
+ * @param stream Output stream (e.g. stderr).
+ */
+static inline void vector_stats_dump(FILE *stream)
+{
+    VectorStatsTable *t = &private_vector_stats_table;
+    const VectorStatsSite *order[VECTOR_STATS_MAX_SITES];
+    size_t n = 0;
+    for (size_t i = 0; i < VECTOR_STATS_MAX_SITES; i++)
+        if (t->sites[i].file != NULL_PTR) order[n++] = &t->sites[i];
+    CLIB_PREFIX qsort(order, n, sizeof(order[0]), private_vector_stats_cmp);
+
+    CLIB_PREFIX fprintf(stream, "vector stats: %zu call sites\n", n);
+    CLIB_PREFIX fprintf(stream, "%10s %14s %14s %12s  %s\n",
+                        "reallocs", "bytes_copied", "peak_capacity", "peak_waste", "site");
+    for (size_t i = 0; i < n; i++)
+        CLIB_PREFIX fprintf(stream, "%10zu %14zu %14zu %12zu  %s:%d\n",
+                            order[i]->reallocs, order[i]->bytes_copied,
+                            order[i]->peak_capacity, order[i]->peak_waste,
+                            order[i]->file, order[i]->line);
+    if (t->dropped != 0)
+        CLIB_PREFIX fprintf(stream, "(%zu reallocations not recorded: raise VECTOR_STATS_MAX_SITES)\n", t->dropped);
+}
+
+/**
+ * Clears every recorded call site.
+ */
+static inline void vector_stats_reset(void)
+{
+    memset(&private_vector_stats_table, 0, sizeof(private_vector_stats_table));
+}
+
+#else
+    #define private_vector_stats_record(file, line, elem_size, old_data, old_cap, new_cap, size) \
+        ((void)(file), (void)(line))
+    #define vector_stats_dump(stream)   ((void)(stream))
+    #define vector_stats_reset()        ((void)0)
+#endif
+
+/**
+ * @section Out-of-line Cold Paths
+ * -------------------------------------------------------------------------
+ * Growth and diagnostics are type-erased functions on VectorBase, so a call
+ * site of vector_push_back & co. keeps only the `size < capacity` check and
+ * the store; the capacity computation, realloc, stats and error report live
+ * in one noinline, cold copy (see VECTOR_COLD_API for the linkage).
+ * `msg` is the diagnostic for an allocation failure, NULL to stay silent.
+ */
+#if !defined(VECTOR_EXTERN) || defined(VECTOR_IMPLEMENTATION)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* !! PRIVATE !! — Do not call directly */
+VECTOR_COLD_API void private_vector_report(const char *msg, const char *file, int line)
+{
+    VECTOR_ON_ERROR(msg, file, line);
+    (void)msg; (void)file; (void)line;
+}
+
+/* !! PRIVATE !! — Moves a vector's buffer to new_capacity elements; 0 on success */
+static inline int private_vector_set_capacity
+(
+    VectorBase *vec, size_t elem_size, size_t new_capacity,
+    const char *msg, const char *file, int line
+)
+
+{
+    private_vector_stats_record(file, line, elem_size, vec->data, vec->capacity, new_capacity, vec->size);
+    void *nd = private_vector_realloc(vec->allocator, vec->data,
+                                      vec->capacity * elem_size, new_capacity * elem_size);
+    if (UNLIKELY(nd == NULL_PTR)) {
+        if (msg != NULL_PTR) private_vector_report(msg, file, line);
+        return -1;
+    }
+    vec->data     = nd;
+    vec->capacity = new_capacity;
+    return 0;
+}
+
+/* !! PRIVATE !! — Grows the buffer by the growth policy so it holds at least `needed` elements */
+VECTOR_COLD_API int private_vector_grow_base
+(
+    void *vec_ptr, size_t elem_size, size_t needed,
+    const char *msg, const char *file, int line
+)
+
+{
+    VectorBase *vec = (VectorBase *)vec_ptr;
+    size_t nc = private_vector_next_capacity(private_vector_growth(vec->allocator),
+                                             vec->capacity, needed, elem_size);
+    return private_vector_set_capacity(vec, elem_size, nc, msg, file, line);
+}
+
+/* !! PRIVATE !! — vector_reserve (policy minimum and rounding) / vector_reserve_exact (granule only) */
+VECTOR_COLD_API int private_vector_reserve_base
+(
+    void *vec_ptr, size_t elem_size, size_t new_capacity, int exact,
+    const char *msg, const char *file, int line
+)
+
+{
+    VectorBase *vec = (VectorBase *)vec_ptr;
+    const VectorGrowthPolicy *p = private_vector_growth(vec->allocator);
+    if (new_capacity < vec->size) new_capacity = vec->size;     /* never drop elements (shared COW vectors have capacity 0) */
+    size_t nc = exact ? private_vector_pad_capacity(p, new_capacity, elem_size)
+                      : private_vector_fit_capacity(p, new_capacity, elem_size);
+    return private_vector_set_capacity(vec, elem_size, nc, msg, file, line);
+}
+
+/* !! PRIVATE !! — vector_shrink_to_fit; frees the buffer of an empty vector, keeps the old one if realloc fails */
+VECTOR_COLD_API void private_vector_shrink_base(void *vec_ptr, size_t elem_size, const char *file, int line)
+{
+    VectorBase *vec = (VectorBase *)vec_ptr;
+    size_t fit = private_vector_pad_capacity(private_vector_growth(vec->allocator), vec->size, elem_size);
+    if (fit >= vec->capacity) return;
+    if (vec->size == 0) {
+        private_vector_free(vec->allocator, vec->data, vec->capacity * elem_size);
+        vec->data     = NULL_PTR;
+        vec->capacity = 0;
+        return;
+    }
+    (void)private_vector_set_capacity(vec, elem_size, fit, NULL_PTR, file, line);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !VECTOR_EXTERN || VECTOR_IMPLEMENTATION */
+
+/**
+ * @section Small-Buffer Vectors
+ * -------------------------------------------------------------------------
+ * `vector_sbo(type, N)` carries N elements of inline storage after the regular
+ * vector fields. `vector_sbo_init` points `data` at the inline buffer and attaches
+ * an allocator that moves to the heap only when the vector outgrows it, so every
+ * other vector macro works on it unchanged.
+ *
+ * @warning An SBO vector must not be copied or moved by value (e.g. returned from a
+ *          function or memcpy'd), because `data` may point into the struct itself.
+ *          vector_swap is fine as long as both vectors stay alive.
+ */
+typedef struct {
+    VectorAllocator allocator;
+    void           *buffer;
+    size_t          bytes;
+} VectorSboHeader;
+
+#define vector_sbo(type, N) \
+    struct { \
+        VECTOR_FIELDS(type) \
+        VectorSboHeader sbo; \
+        type            sbo_buffer[(N)]; \
+    }
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_sbo_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorSboHeader *h = (VectorSboHeader *)ctx;
+    if (ptr != h->buffer) return VECTOR_REALLOC(ptr, new_size);
+    if (new_size <= h->bytes) return ptr;
+    void *nd = VECTOR_REALLOC(NULL_PTR, new_size);
+    if (LIKELY(nd != NULL_PTR)) memcpy(nd, ptr, old_size);
+    return nd;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_sbo_free(void *ctx, void *ptr, size_t size)
+{
+    VectorSboHeader *h = (VectorSboHeader *)ctx;
+    (void)size;
+    if (ptr != h->buffer) VECTOR_FREE(ptr);
+}
+
+/**
+ * Initializes a `vector_sbo(type, N)`. The vector starts with capacity N and
+ * no heap allocation.
+ * @param vec The SBO vector structure to initialize.
+ */
+#define vector_sbo_init(vec) do { \
+    VECTOR_ASSERT_TRIVIAL(vec); \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    (vec).sbo.allocator.realloc_fn = private_vector_sbo_realloc; \
+    (vec).sbo.allocator.free_fn    = private_vector_sbo_free; \
+    (vec).sbo.allocator.ctx        = &(vec).sbo; \
+    (vec).sbo.allocator.growth     = NULL_PTR; \
+    (vec).sbo.buffer               = (vec).sbo_buffer; \
+    (vec).sbo.bytes                = sizeof((vec).sbo_buffer); \
+    (vec).data      = (vec).sbo_buffer; \
+    (vec).size      = 0; \
+    (vec).capacity  = sizeof((vec).sbo_buffer) / sizeof((vec).sbo_buffer[0]); \
+    (vec).allocator = &(vec).sbo.allocator; \
+    private_vector_set_magic(vec, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * @brief Nonzero while an SBO vector's elements live in its inline buffer.
+ */
+#define vector_sbo_is_inline(vec) ((void *)(vec).data == (void *)(vec).sbo_buffer)
+
+/**
+ * @section Aligned Vectors
+ * -------------------------------------------------------------------------
+ * `vector_aligned(type, align)` is a regular vector whose buffer always starts on
+ * an `align`-byte boundary and whose byte capacity is always a multiple of
+ * `align`, across push_back, reserve, reserve_exact and shrink_to_fit. Kernels can
+ * therefore use aligned SIMD loads and process whole registers up to the capacity
+ * without a scalar tail, and the buffer can be handed to APIs that require
+ * aligned uploads (e.g. glBufferData with a persistent mapping).
+ *
+ * The alignment lives in a static allocator shared by every vector of that
+ * alignment, so unlike SBO vectors an aligned vector may be copied by value.
+ * `align` must be a power of two no larger than VECTOR_ALIGNED_MAX; pick at least
+ * the widest SIMD register in use (32 for AVX2, 64 for AVX-512 or a cache line).
+ *
+ * @warning Initialize with vector_aligned_init; vector_init would attach the
+ *          plain heap allocator and lose the alignment.
+ */
+#ifndef VECTOR_ALIGNED_MAX
+    #define VECTOR_ALIGNED_MAX 4096
+#endif
+
+#define vector_aligned(type, align) \
+    struct { \
+        VECTOR_FIELDS(type) \
+        char (*alignment)[(align)];     /* never set; sizeof(*alignment) == align */ \
+    }
+
+/* !! PRIVATE !! — Do not call directly. Keeps the raw block pointer just before the aligned block. */
+static inline void *private_vector_aligned_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    size_t align = ((const VectorGrowthPolicy *)ctx)->granule;
+    size_t extra = align - 1 + sizeof(void *);
+    if (UNLIKELY(new_size > SIZE_MAX - extra)) return NULL_PTR;
+
+    void  *old_raw = ptr ? ((void **)ptr)[-1] : NULL_PTR;
+    size_t offset  = ptr ? (size_t)((char *)ptr - (char *)old_raw) : 0;
+    char  *raw     = (char *)VECTOR_REALLOC(old_raw, new_size + extra);
+    if (UNLIKELY(raw == NULL_PTR)) return NULL_PTR;
+
+    uintptr_t aligned = ((uintptr_t)raw + sizeof(void *) + align - 1) & ~(uintptr_t)(align - 1);
+    if (ptr && (char *)aligned != raw + offset)     /* realloc moved the block off alignment */
+        memmove((void *)aligned, raw + offset, old_size < new_size ? old_size : new_size);
+    ((void **)aligned)[-1] = raw;
+    return (void *)aligned;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_aligned_free(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx; (void)size;
+    if (ptr) VECTOR_FREE(((void **)ptr)[-1]);
+}
+
+/* !! PRIVATE !! — Growth policy of alignment 2^shift: default growth, capacity padded to the alignment */
+#define PRIVATE_VECTOR_ALIGNED_POLICY(shift) \
+    { VECTOR_GROWTH_KIND, VECTOR_GROWTH_MIN_CAPACITY, VECTOR_GROWTH_MAX_STEP, \
+      VECTOR_GROWTH_THRESHOLD, VECTOR_GROWTH_CHUNK, NULL_PTR, (size_t)1 << (shift) }
+
+#define PRIVATE_VECTOR_ALIGNED_ALLOCATOR(shift) \
+    { private_vector_aligned_realloc, private_vector_aligned_free, \
+      (void *)&private_vector_aligned_policies[(shift)], &private_vector_aligned_policies[(shift)] }
+
+static const VectorGrowthPolicy private_vector_aligned_policies[13] = {
+    PRIVATE_VECTOR_ALIGNED_POLICY(0),  PRIVATE_VECTOR_ALIGNED_POLICY(1),  PRIVATE_VECTOR_ALIGNED_POLICY(2),
+    PRIVATE_VECTOR_ALIGNED_POLICY(3),  PRIVATE_VECTOR_ALIGNED_POLICY(4),  PRIVATE_VECTOR_ALIGNED_POLICY(5),
+    PRIVATE_VECTOR_ALIGNED_POLICY(6),  PRIVATE_VECTOR_ALIGNED_POLICY(7),  PRIVATE_VECTOR_ALIGNED_POLICY(8),
+    PRIVATE_VECTOR_ALIGNED_POLICY(9),  PRIVATE_VECTOR_ALIGNED_POLICY(10), PRIVATE_VECTOR_ALIGNED_POLICY(11),
+    PRIVATE_VECTOR_ALIGNED_POLICY(12),
+};
+
+static const VectorAllocator private_vector_aligned_allocators[13] = {
+    PRIVATE_VECTOR_ALIGNED_ALLOCATOR(0),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(1),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(2),
+    PRIVATE_VECTOR_ALIGNED_ALLOCATOR(3),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(4),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(5),
+    PRIVATE_VECTOR_ALIGNED_ALLOCATOR(6),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(7),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(8),
+    PRIVATE_VECTOR_ALIGNED_ALLOCATOR(9),  PRIVATE_VECTOR_ALIGNED_ALLOCATOR(10), PRIVATE_VECTOR_ALIGNED_ALLOCATOR(11),
+    PRIVATE_VECTOR_ALIGNED_ALLOCATOR(12),
+};
+
+/**
+ * Returns the shared allocator for a power-of-two alignment (NULL if unsupported).
+ * Lets an ordinary `vector(type)` opt into aligned storage:
+ * @example
+ *   vector_init_with_allocator(samples, vector_aligned_allocator(32));
+ */
+static inline const VectorAllocator *vector_aligned_allocator(size_t align)
+{
+    if (align == 0 || (align & (align - 1)) != 0 || align > VECTOR_ALIGNED_MAX || align > 4096)
+        return NULL_PTR;
+    return &private_vector_aligned_allocators[VECTOR_CTZ64(align)];
+}
+
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_ASSERT_ALIGNMENT(vec) \
+        static_assert((sizeof(*(vec).alignment) & (sizeof(*(vec).alignment) - 1)) == 0 && \
+                      sizeof(*(vec).alignment) <= VECTOR_ALIGNED_MAX && sizeof(*(vec).alignment) <= 4096, \
+                      "vector_aligned: align must be a power of two <= VECTOR_ALIGNED_MAX")
+#else
+    #define PRIVATE_VECTOR_ASSERT_ALIGNMENT(vec) \
+        _Static_assert((sizeof(*(vec).alignment) & (sizeof(*(vec).alignment) - 1)) == 0 && \
+                       sizeof(*(vec).alignment) <= VECTOR_ALIGNED_MAX && sizeof(*(vec).alignment) <= 4096, \
+                       "vector_aligned: align must be a power of two <= VECTOR_ALIGNED_MAX")
+#endif
+
+/**
+ * Initializes a `vector_aligned(type, align)`. No memory is allocated until the first growth.
+ * @param vec The aligned vector structure to initialize.
+ */
+#define vector_aligned_init(vec) do { \
+    PRIVATE_VECTOR_ASSERT_ALIGNMENT(vec); \
+    (vec).alignment = NULL_PTR; \
+    vector_init_with_allocator(vec, vector_aligned_allocator(sizeof(*(vec).alignment))); \
+} while(0)
+
+/**
+ * @brief `(vec).data` with its alignment made known to the compiler (type*), so loops
+ *        over it can use aligned vector loads. Only valid while capacity > 0.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define vector_aligned_data(vec) \
+        ((TYPE_OF((vec).data))__builtin_assume_aligned((vec).data, sizeof(*(vec).alignment)))
+#else
+    #define vector_aligned_data(vec) ((vec).data)
+#endif
+
+/**
+ * @section Views
+ * -------------------------------------------------------------------------
+ * `vector_view(type)` is a read-only, non-owning vector over memory the library
+ * must not free (a mapped file, a decoder's frame, part of another vector). Its
+ * layout matches vector(const type), so the read-only macros (vector_at,
+ * vector_foreach, vector_find*, vector_count, the bound/search macros) work on it
+ * directly, while mutating macros fail to compile on the const elements.
+ * A view is never destroyed; it is valid as long as the memory it points at.
+ */
+#define vector_view(type) \
+    struct { \
+        VECTOR_FIELDS(const type) \
+    }
+
+/**
+ * Points a view at `length` elements starting at `ptr`.
+ * @param view The view to set up (may be re-pointed any number of times).
+ */
+#define vector_view_init(view, ptr, length) do { \
+    (view).data      = (ptr); \
+    (view).size      = (size_t)(length); \
+    (view).capacity  = (view).size; \
+    (view).allocator = NULL_PTR; \
+    private_vector_set_magic(view, VECTOR_MAGIC_INIT); \
 } while(0)
 
-/* Growth strategy: double capacity, minimum 4 */
-#define VECTOR_GROW_CAPACITY(cap) ((cap) < 4 ? 4 : (cap) << 1)
+/**
+ * Points a view at the current elements of a vector. The view is invalidated by
+ * anything that reallocates the vector.
+ */
+#define vector_view_of(view, vec) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_view_of'", __FILE__, __LINE__); \
+        break; \
+    } \
+    vector_view_init(view, (vec).data, (vec).size); \
+} while(0)
+
+/**
+ * Replaces the contents of an initialized vector with a copy of the view's elements
+ * (one reservation, one memcpy).
+ */
+#define vector_from_view(vec, view) do { \
+    (void)sizeof((vec).data == (view).data);    /* element types must match */ \
+    if (UNLIKELY(!vector_is_valid(vec) || !vector_is_valid(view))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_from_view'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = (view).size; \
+    (vec).size = 0; \
+    TYPE_OF((vec).data) _dst = vector_append_uninit(vec, _n); \
+    if (_n != 0 && _dst != NULL_PTR) memcpy((void *)_dst, (const void *)(view).data, _n * sizeof(*(vec).data)); \
+} while(0)
 
 /** 
  * Appends an element to the end of the vector, automatically resizing the 
@@ -189,20 +1023,13 @@ typedef struct {
  * @param value The element to be added (must match the vector's type).
  */
 #define vector_push_back(vec, value) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_push_back' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_push_back'", __FILE__, __LINE__); \
         break; \
     } \
-    if (UNLIKELY((vec).size >= (vec).capacity)) { \
-        size_t _nc = VECTOR_GROW_CAPACITY((vec).capacity); \
-        TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, _nc * sizeof(*(vec).data)); \
-        if (UNLIKELY(_nd == NULL_PTR)) { \
-            CLIB_PREFIX fprintf(stderr, "[x] Error: allocation failed in 'vector_push_back' at %s:%d\n", __FILE__, __LINE__); \
-            break; \
-        } \
-        (vec).data     = _nd; \
-        (vec).capacity = _nc; \
-    } \
+    if (UNLIKELY((vec).size >= (vec).capacity) && \
+        private_vector_grow_base(&(vec), sizeof(*(vec).data), (vec).size + 1, \
+            "[x] Error: allocation failed in 'vector_push_back'", __FILE__, __LINE__) != 0) break; \
     (vec).data[(vec).size++] = (value); \
 } while(0)
 
@@ -218,20 +1045,12 @@ typedef struct {
  */
 #define private_vector_emplace_back_ptr(vec) ({ \
     TYPE_OF_VAL((vec).data) _slot = NULL_PTR; \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_emplace_back' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_emplace_back'", __FILE__, __LINE__); \
     } else { \
-        if (UNLIKELY((vec).size >= (vec).capacity)) { \
-            size_t _nc = VECTOR_GROW_CAPACITY((vec).capacity); \
-            TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, _nc * sizeof(*(vec).data)); \
-            if (LIKELY(_nd != NULL_PTR)) { \
-                (vec).data     = _nd; \
-                (vec).capacity = _nc; \
-            } else { \
-                CLIB_PREFIX fprintf(stderr, "[x] Error: allocation failed in 'vector_emplace_back' at %s:%d\n", __FILE__, __LINE__); \
-            } \
-        } \
-        if ((vec).size < (vec).capacity) \
+        if (LIKELY((vec).size < (vec).capacity) || \
+            private_vector_grow_base(&(vec), sizeof(*(vec).data), (vec).size + 1, \
+                "[x] Error: allocation failed in 'vector_emplace_back'", __FILE__, __LINE__) == 0) \
             _slot = &(vec).data[(vec).size++]; \
     } \
     _slot; \
@@ -262,48 +1081,79 @@ typedef struct {
     } \
 } while(0)
 
+/**
+ * Appends an element WITHOUT a capacity check. The caller guarantees
+ * size < capacity (e.g. after vector_reserve), so a reserve-then-fill loop
+ * compiles to a plain store loop.
+ * @note Debug builds abort on an uninitialized or full vector; VECTOR_UNCHECKED removes the check.
+ * @param vec   The vector structure to modify.
+ * @param value The element to be added (must match the vector's type).
+ */
+#define vector_push_back_unchecked(vec, value) do { \
+    VECTOR_ASSERT(vector_is_valid(vec) && (vec).size < (vec).capacity, \
+                  "[x] Error: no reserved capacity left in 'vector_push_back_unchecked'"); \
+    (vec).data[(vec).size++] = (value); \
+} while(0)
+
+/**
+ * Constructs an element in-place at the end WITHOUT a capacity check.
+ * Same contract as vector_push_back_unchecked, same initializer rules as vector_emplace_back.
+ */
+#define vector_emplace_back_unchecked(vec, ...) do { \
+    VECTOR_ASSERT(vector_is_valid(vec) && (vec).size < (vec).capacity, \
+                  "[x] Error: no reserved capacity left in 'vector_emplace_back_unchecked'"); \
+    TYPE_OF_VAL(*(vec).data) _tmp = { __VA_ARGS__ }; \
+    (vec).data[(vec).size++] = _tmp; \
+} while(0)
+
 #define vector_size(vec)        ((vec).size)
 #define vector_bytesize(vec)    ((vec).size * sizeof(*(vec).data))
 #define vector_capacity(vec)    ((vec).capacity)
 #define vector_empty(vec)       ((vec).size == 0)
 
+#ifdef VECTOR_UNCHECKED
+    #define vector_at(vec, index)   ((vec).data[(index)])
+    #define vector_back(vec)        ((vec).data[(vec).size - 1])
+    #define vector_front(vec)       ((vec).data[0])
+#else
 /**
  * @brief Bounds-checked element access. Aborts on out-of-bounds or uninitialized vector.
  */
 #define vector_at(vec, index) \
-    (((vec).magic == VECTOR_MAGIC_INIT && (size_t)(index) < (vec).size) ? \
+    ((vector_is_valid(vec) && (size_t)(index) < (vec).size) ? \
      (vec).data[(index)] : \
-     (CLIB_PREFIX fprintf(stderr, "[x] Error: out-of-bounds access at %s:%d\n", __FILE__, __LINE__), \
+     (private_vector_fail("[x] Error: out-of-bounds access", __FILE__, __LINE__), \
       abort(), VECTOR_UNREACHABLE(), (vec).data[0]))
 
 /**
  * @brief Returns the last element. Aborts on empty or uninitialized vector.
  */
 #define vector_back(vec) \
-    (((vec).magic == VECTOR_MAGIC_INIT && (vec).size > 0) ? \
+    ((vector_is_valid(vec) && (vec).size > 0) ? \
      (vec).data[(vec).size - 1] : \
-     (CLIB_PREFIX fprintf(stderr, "[x] Error: 'vector_back' on empty/uninitialized vector at %s:%d\n", __FILE__, __LINE__), \
+     (private_vector_fail("[x] Error: 'vector_back' on empty/uninitialized vector", __FILE__, __LINE__), \
       abort(), VECTOR_UNREACHABLE(), (vec).data[0]))
 
 /**
  * @brief Returns the first element. Aborts on empty or uninitialized vector.
  */
 #define vector_front(vec) \
-    (((vec).magic == VECTOR_MAGIC_INIT && (vec).size > 0) ? \
+    ((vector_is_valid(vec) && (vec).size > 0) ? \
      (vec).data[0] : \
-     (CLIB_PREFIX fprintf(stderr, "[x] Error: 'vector_front' on empty/uninitialized vector at %s:%d\n", __FILE__, __LINE__), \
+     (private_vector_fail("[x] Error: 'vector_front' on empty/uninitialized vector", __FILE__, __LINE__), \
       abort(), VECTOR_UNREACHABLE(), (vec).data[0]))
+#endif
 
 /**
  * Removes the last element from the vector.
  */
 #define vector_pop_back(vec) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_pop_back' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_pop_back'", __FILE__, __LINE__); \
         break; \
     } \
-    if (UNLIKELY((vec).size == 0)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: 'vector_pop_back' on empty vector at %s:%d\n", __FILE__, __LINE__); \
+    if (VECTOR_CHECK((vec).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_pop_back' on empty vector", __FILE__, __LINE__); \
         break; \
     } \
     (vec).size--; \
@@ -313,8 +1163,8 @@ typedef struct {
  * Resets vector size to 0 without freeing memory.
  */
 #define vector_clear(vec) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_clear' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_clear'", __FILE__, __LINE__); \
         break; \
     } \
     (vec).size = 0; \
@@ -326,21 +1176,70 @@ typedef struct {
  * @param vec The vector structure to destroy. 
  */
 #define vector_destroy(vec) do { \
-    if ((vec).magic == VECTOR_MAGIC_DESTROYED) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector already destroyed at %s:%d\n", __FILE__, __LINE__); \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
         break; \
     } \
-    if ((vec).magic != VECTOR_MAGIC_INIT) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before destroy at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
         break; \
     } \
-    free((vec).data); \
+    private_vector_free((vec).allocator, (vec).data, (vec).capacity * sizeof(*(vec).data)); \
     (vec).data     = NULL_PTR; \
     (vec).size     = 0; \
     (vec).capacity = 0; \
-    (vec).magic    = VECTOR_MAGIC_DESTROYED; \
+    private_vector_set_magic(vec, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+/**
+ * Takes ownership of an existing buffer without copying it. The vector's previous
+ * buffer is freed first.
+ * @param vec    An initialized vector.
+ * @param ptr    Buffer of at least `cap` elements, obtained from the vector's allocator
+ *               (malloc/realloc, or VECTOR_REALLOC, for vectors set up with vector_init).
+ * @param length Number of live elements in `ptr` (<= cap).
+ * @param cap    Capacity of `ptr`, in elements.
+ */
+#define vector_adopt(vec, ptr, length, cap) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_adopt'", __FILE__, __LINE__); \
+        break; \
+    } \
+    TYPE_OF((vec).data) _ptr = (ptr); \
+    size_t _size = (size_t)(length), _cap = (size_t)(cap); \
+    if (VECTOR_CHECK(_size > _cap || (_ptr == NULL_PTR && _cap != 0))) { \
+        private_vector_fail("[x] Error: invalid buffer (size > cap or NULL) in 'vector_adopt'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((vec).data != _ptr) \
+        private_vector_free((vec).allocator, (vec).data, (vec).capacity * sizeof(*(vec).data)); \
+    (vec).data     = _ptr; \
+    (vec).size     = _size; \
+    (vec).capacity = _cap; \
 } while(0)
 
+/**
+ * Hands the buffer back to the caller and leaves the vector empty (still initialized).
+ * Read vector_size / vector_capacity first if you need them.
+ * @return (type*) The buffer, or NULL if the vector had none. The caller frees it with
+ *         the allocator that produced it (free() for vectors set up with vector_init).
+ * @warning Do not release an SBO vector while vector_sbo_is_inline.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_release(vec) ({ \
+    TYPE_OF((vec).data) _released = NULL_PTR; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_release'", __FILE__, __LINE__); \
+    } else { \
+        _released      = (vec).data; \
+        (vec).data     = NULL_PTR; \
+        (vec).size     = 0; \
+        (vec).capacity = 0; \
+    } \
+    _released; \
+})
+
 /** 
  * Reserves capacity for at least new_capacity elements.
  * No-op if current capacity already satisfies the request.
@@ -349,21 +1248,41 @@ typedef struct {
  *       in the assignment — these are now consistent.
  */
 #define vector_reserve(vec, new_capacity) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_reserve' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_reserve'", __FILE__, __LINE__); \
         break; \
     } \
     if ((new_capacity) <= (vec).capacity) break; \
-    size_t _cap = (new_capacity) < 4 ? 4 : (size_t)(new_capacity); \
-    TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, _cap * sizeof(*(vec).data)); \
-    if (LIKELY(_nd != NULL_PTR)) { \
-        (vec).data     = _nd; \
-        (vec).capacity = _cap; \
-    } else { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: allocation failed in 'vector_reserve' at %s:%d\n", __FILE__, __LINE__); \
+    (void)private_vector_reserve_base(&(vec), sizeof(*(vec).data), (size_t)(new_capacity), 0, \
+        "[x] Error: allocation failed in 'vector_reserve'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Reserves capacity for exactly new_capacity elements.
+ * Unlike vector_reserve, no minimum capacity or page rounding is applied
+ * (only the growth policy `granule`, if the allocator sets one).
+ * No-op if current capacity already satisfies the request.
+ */
+#define vector_reserve_exact(vec, new_capacity) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_reserve_exact'", __FILE__, __LINE__); \
+        break; \
     } \
+    if ((size_t)(new_capacity) <= (vec).capacity) break; \
+    (void)private_vector_reserve_base(&(vec), sizeof(*(vec).data), (size_t)(new_capacity), 1, \
+        "[x] Error: allocation failed in 'vector_reserve_exact'", __FILE__, __LINE__); \
 } while(0)
 
+/* !! PRIVATE !! — memset fill when every byte of the value is the same (0, -1, 'a'...); returns 0 otherwise */
+static inline int private_vector_fill_bytes(void *dst, const void *value, size_t elem_size, size_t count)
+{
+    const unsigned char *b = (const unsigned char *)value;
+    for (size_t i = 1; i < elem_size; i++)
+        if (b[i] != b[0]) return 0;
+    memset(dst, b[0], elem_size * count);
+    return 1;
+}
+
 /** 
  * Resizes the vector to contain new_size elements.
  * Expands with def_val or truncates as needed.
@@ -372,10 +1291,8 @@ typedef struct {
  * @param def_val  Value to fill new slots with (if expanding).
  */
 #define vector_resize(vec, new_size, def_val) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, \
-        "[x] Error: vector not initialized before 'vector_resize' at %s:%d\n", \
-        __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_resize'", __FILE__, __LINE__); \
         break; \
     } \
     if ((size_t)(new_size) > (vec).capacity) { \
@@ -384,8 +1301,10 @@ typedef struct {
     } \
     if ((size_t)(new_size) > (vec).size) { \
         TYPE_OF_VAL(*(vec).data) _fv = (def_val); \
-    for (size_t _i = (vec).size; _i < (size_t)(new_size); _i++) \
-        (vec).data[_i] = _fv; \
+        if (!private_vector_fill_bytes(&(vec).data[(vec).size], &_fv, sizeof(_fv), \
+                                       (size_t)(new_size) - (vec).size)) \
+            for (size_t _i = (vec).size; _i < (size_t)(new_size); _i++) \
+                (vec).data[_i] = _fv; \
     } \
     (vec).size = (size_t)(new_size); \
 } while(0)
@@ -395,15 +1314,14 @@ typedef struct {
  * @brief Resizes the vector to `new_size` elements.
  *        ALL elements (existing + new) are overwritten with `def_val`.
  *        Useful for reinitializing the entire buffer to a known state.
- * @note  Release builds (-O2) auto-vectorize the fill loop to memset/SIMD.
+ * @note  Values whose bytes are all equal (0, -1, ...) are filled with memset;
+ *        other values use a loop that -O2 auto-vectorizes.
  * @note  Unlike `vector_resize`, this always overwrites from index 0,
  *        so existing data is not preserved.
  */
 #define vector_resize_full(vec, new_size, def_val) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, \
-            "[x] Error: vector not initialized before 'vector_resize_full' at %s:%d\n", \
-            __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_resize_full'", __FILE__, __LINE__); \
         break; \
     } \
     if ((size_t)(new_size) > (vec).capacity) { \
@@ -411,33 +1329,155 @@ typedef struct {
         if (UNLIKELY((vec).capacity < (size_t)(new_size))) break; \
     } \
     TYPE_OF_VAL(*(vec).data) _fv = (def_val); \
-    for (size_t _i = 0; _i < (size_t)(new_size); _i++) \
-        (vec).data[_i] = _fv; \
+    if (!private_vector_fill_bytes((vec).data, &_fv, sizeof(_fv), (size_t)(new_size))) \
+        for (size_t _i = 0; _i < (size_t)(new_size); _i++) \
+            (vec).data[_i] = _fv; \
     (vec).size = (size_t)(new_size); \
 } while(0)
 
+/**
+ * Resizes the vector to new_size elements WITHOUT initializing new slots.
+ * Use when the tail is about to be overwritten (fread, recv, GPU readback).
+ * @param vec      The vector structure to modify.
+ * @param new_size The new size of the vector.
+ * @return Pointer to element [old size] (the start of the uninitialized tail),
+ *         or NULL_PTR on failure (size unchanged). When shrinking, points to element [new_size].
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_resize_uninit(vec, new_size) ({ \
+    TYPE_OF_VAL((vec).data) _tail = NULL_PTR; \
+    size_t _ns = (size_t)(new_size); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_resize_uninit'", __FILE__, __LINE__); \
+    } else { \
+        if (_ns > (vec).capacity) vector_reserve(vec, _ns); \
+        if (LIKELY((vec).capacity >= _ns)) { \
+            _tail = (vec).data + (_ns < (vec).size ? _ns : (vec).size); \
+            (vec).size = _ns; \
+        } \
+    } \
+    _tail; \
+})
+
+/**
+ * Appends count uninitialized elements, growing with the vector's growth policy.
+ * @param vec   The vector structure to modify.
+ * @param count Number of elements to append.
+ * @return Pointer to the first appended element, or NULL_PTR on failure (size unchanged).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_append_uninit(vec, count) ({ \
+    TYPE_OF_VAL((vec).data) _tail = NULL_PTR; \
+    size_t _ns = (vec).size + (size_t)(count); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_append_uninit'", __FILE__, __LINE__); \
+    } else { \
+        if (LIKELY(_ns <= (vec).capacity) || \
+            private_vector_grow_base(&(vec), sizeof(*(vec).data), _ns, \
+                "[x] Error: allocation failed in 'vector_append_uninit'", __FILE__, __LINE__) == 0) { \
+            _tail = (vec).data + (vec).size; \
+            (vec).size = _ns; \
+        } \
+    } \
+    _tail; \
+})
+
+/* !! PRIVATE !! — Appends count elements from src in one growth and one memcpy; src may point into vec */
+static inline int private_vector_append_inline
+(
+    void *vec_ptr, size_t elem_size,
+    const void *src, size_t count,
+    const char *msg, const char *file, int line
+)
+
+{
+    VectorBase *vec = (VectorBase *)vec_ptr;
+    size_t new_size = vec->size + count;
+    if (UNLIKELY(new_size < count)) {
+        private_vector_fail(msg, file, line);
+        return -1;
+    }
+    if (UNLIKELY(new_size > vec->capacity)) {
+        const char *old = (const char *)vec->data;
+        int self = src != NULL_PTR && old != NULL_PTR &&
+                   (const char *)src >= old && (const char *)src < old + vec->size * elem_size;
+        size_t offset = self ? (size_t)((const char *)src - old) : 0;
+        if (private_vector_grow_base(vec, elem_size, new_size, msg, file, line) != 0) return -1;
+        if (self) src = (const char *)vec->data + offset;
+    }
+    if (count != 0) memcpy((char *)vec->data + vec->size * elem_size, src, count * elem_size);
+    vec->size = new_size;
+    return 0;
+}
+
+/**
+ * Appends count elements copied from arr: at most one growth (by the growth
+ * policy, so repeated appends stay amortized O(1)), then one memcpy.
+ * @param vec   The vector structure to modify.
+ * @param arr   Pointer to count elements of the vector's type (may point into vec).
+ * @param count Number of elements to append.
+ */
+#define vector_append_array(vec, arr, count) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_append_array'", __FILE__, __LINE__); \
+        break; \
+    } \
+    const TYPE_OF_VAL(*(vec).data) *_src = (arr); \
+    size_t _cnt = (size_t)(count); \
+    if (VECTOR_CHECK(_src == NULL_PTR && _cnt != 0)) { \
+        private_vector_fail("[x] Error: source array is NULL in 'vector_append_array'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (void)private_vector_append_inline(&(vec), sizeof(*(vec).data), _src, _cnt, \
+        "[x] Error: allocation failed in 'vector_append_array'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Appends every element of src to vec (one growth, one memcpy).
+ * vector_extend(vec, vec) doubles the contents.
+ * @param vec The vector structure to modify.
+ * @param src Vector (or view) with the same element type.
+ */
+#define vector_extend(vec, src) do { \
+    (void)sizeof((vec).data == (src).data);     /* element types must match */ \
+    if (UNLIKELY(!vector_is_valid(vec) || !vector_is_valid(src))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_extend'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (void)private_vector_append_inline(&(vec), sizeof(*(vec).data), (src).data, (src).size, \
+        "[x] Error: allocation failed in 'vector_extend'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Appends count elements produced by gen: element k of the new tail (k = 0..count-1)
+ * is gen(k). One growth, then a plain indexed loop with no per-element capacity
+ * check, which the compiler vectorizes (GCC -O3) for simple gen expressions.
+ * @param vec   The vector structure to modify.
+ * @param count Number of elements to append.
+ * @param gen   Function or macro: gen(k) -> element. Must not modify vec.
+ */
+#define vector_extend_gen(vec, count, gen) do { \
+    size_t _gen_n = (size_t)(count); \
+    TYPE_OF((vec).data) _gen_dst = vector_append_uninit(vec, _gen_n); \
+    if (UNLIKELY(_gen_dst == NULL_PTR)) break; \
+    for (size_t _k = 0; _k < _gen_n; _k++) _gen_dst[_k] = gen(_k); \
+} while(0)
+
 
 /** 
- * Shrinks the internal buffer to match the current size exactly.
+ * Shrinks the internal buffer to match the current size exactly
+ * (padded to the growth policy `granule`, if the allocator sets one).
  * If the vector is empty, fully deallocates the buffer.
  */
 #define vector_shrink_to_fit(vec) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_shrink_to_fit' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_shrink_to_fit'", __FILE__, __LINE__); \
         break; \
     } \
-    if ((vec).size == (vec).capacity) break; \
-    if ((vec).size == 0) { \
-        free((vec).data); \
-        (vec).data     = NULL_PTR; \
-        (vec).capacity = 0; \
-    } else { \
-        TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, (vec).size * sizeof(*(vec).data)); \
-        if (LIKELY(_nd != NULL_PTR)) { \
-            (vec).data     = _nd; \
-            (vec).capacity = (vec).size; \
-        } \
-    } \
+    if ((vec).size < (vec).capacity) \
+        private_vector_shrink_base(&(vec), sizeof(*(vec).data), __FILE__, __LINE__); \
 } while(0)
 
 /** 
@@ -451,6 +1491,238 @@ typedef struct {
          item < (vec).data + (vec).size; \
          ++item)
 
+/**
+ * @section SIMD Scan Kernels
+ * -------------------------------------------------------------------------
+ * vector_find, vector_find_last and vector_count dispatch on the element type
+ * (_Generic in C, overloads in C++) to SIMD kernels for 8/16/32/64-bit integers,
+ * float and double. The instruction set is picked at compile time:
+ * AVX-512BW > AVX2 > SSE2 > NEON (AArch64). Compile with e.g. -mavx2 to enable
+ * the wider kernels. Any other element type, or VECTOR_NO_SIMD, uses the scalar loop.
+ *
+ * Each kernel compares one register of elements against the key and reduces
+ * the result to a bit mask with VECTOR_SIMD_BITS(T) bits per matching element.
+ */
+#if !defined(VECTOR_NO_SIMD)
+    #if defined(__AVX512BW__)
+        #define VECTOR_SIMD_AVX512 1
+    #elif defined(__AVX2__)
+        #define VECTOR_SIMD_AVX2   1
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define VECTOR_SIMD_SSE2   1
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define VECTOR_SIMD_NEON   1
+    #endif
+#endif
+
+#if defined(VECTOR_SIMD_AVX512) || defined(VECTOR_SIMD_AVX2) || defined(VECTOR_SIMD_SSE2)
+    #include <immintrin.h>
+#elif defined(VECTOR_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+#if defined(VECTOR_SIMD_AVX512)
+    #define VECTOR_SIMD_BYTES       64
+    #define VECTOR_SIMD_BITS(T)     1
+    #define private_vector_simd_key_u8(v)   _mm512_set1_epi8((char)(v))
+    #define private_vector_simd_key_u16(v)  _mm512_set1_epi16((short)(v))
+    #define private_vector_simd_key_u32(v)  _mm512_set1_epi32((int)(v))
+    #define private_vector_simd_key_u64(v)  _mm512_set1_epi64((long long)(v))
+    #define private_vector_simd_key_f32(v)  _mm512_set1_ps(v)
+    #define private_vector_simd_key_f64(v)  _mm512_set1_pd(v)
+    #define private_vector_simd_mask_u8(p, k)  ((uint64_t)_mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(p)), k))
+    #define private_vector_simd_mask_u16(p, k) ((uint64_t)_mm512_cmpeq_epi16_mask(_mm512_loadu_si512((const void *)(p)), k))
+    #define private_vector_simd_mask_u32(p, k) ((uint64_t)_mm512_cmpeq_epi32_mask(_mm512_loadu_si512((const void *)(p)), k))
+    #define private_vector_simd_mask_u64(p, k) ((uint64_t)_mm512_cmpeq_epi64_mask(_mm512_loadu_si512((const void *)(p)), k))
+    #define private_vector_simd_mask_f32(p, k) ((uint64_t)_mm512_cmp_ps_mask(_mm512_loadu_ps((const float *)(const void *)(p)), k, _CMP_EQ_OQ))
+    #define private_vector_simd_mask_f64(p, k) ((uint64_t)_mm512_cmp_pd_mask(_mm512_loadu_pd((const double *)(const void *)(p)), k, _CMP_EQ_OQ))
+#elif defined(VECTOR_SIMD_AVX2)
+    #define VECTOR_SIMD_BYTES       32
+    #define VECTOR_SIMD_BITS(T)     sizeof(T)
+    #define private_vector_simd_key_u8(v)   _mm256_set1_epi8((char)(v))
+    #define private_vector_simd_key_u16(v)  _mm256_set1_epi16((short)(v))
+    #define private_vector_simd_key_u32(v)  _mm256_set1_epi32((int)(v))
+    #define private_vector_simd_key_u64(v)  _mm256_set1_epi64x((long long)(v))
+    #define private_vector_simd_key_f32(v)  _mm256_set1_ps(v)
+    #define private_vector_simd_key_f64(v)  _mm256_set1_pd(v)
+    #define private_vector_simd_load(p)     _mm256_loadu_si256((const __m256i *)(const void *)(p))
+    #define private_vector_simd_bytes(c)    ((uint64_t)(uint32_t)_mm256_movemask_epi8(c))
+    #define private_vector_simd_mask_u8(p, k)  private_vector_simd_bytes(_mm256_cmpeq_epi8(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u16(p, k) private_vector_simd_bytes(_mm256_cmpeq_epi16(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u32(p, k) private_vector_simd_bytes(_mm256_cmpeq_epi32(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u64(p, k) private_vector_simd_bytes(_mm256_cmpeq_epi64(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_f32(p, k) private_vector_simd_bytes(_mm256_castps_si256( \
+        _mm256_cmp_ps(_mm256_loadu_ps((const float *)(const void *)(p)), k, _CMP_EQ_OQ)))
+    #define private_vector_simd_mask_f64(p, k) private_vector_simd_bytes(_mm256_castpd_si256( \
+        _mm256_cmp_pd(_mm256_loadu_pd((const double *)(const void *)(p)), k, _CMP_EQ_OQ)))
+#elif defined(VECTOR_SIMD_SSE2)
+    #define VECTOR_SIMD_BYTES       16
+    #define VECTOR_SIMD_BITS(T)     sizeof(T)
+    #define private_vector_simd_key_u8(v)   _mm_set1_epi8((char)(v))
+    #define private_vector_simd_key_u16(v)  _mm_set1_epi16((short)(v))
+    #define private_vector_simd_key_u32(v)  _mm_set1_epi32((int)(v))
+    #define private_vector_simd_key_u64(v)  _mm_set1_epi64x((long long)(v))
+    #define private_vector_simd_key_f32(v)  _mm_set1_ps(v)
+    #define private_vector_simd_key_f64(v)  _mm_set1_pd(v)
+    #define private_vector_simd_load(p)     _mm_loadu_si128((const __m128i *)(const void *)(p))
+    #define private_vector_simd_bytes(c)    ((uint64_t)(uint32_t)_mm_movemask_epi8(c))
+    /* SSE2 has no 64-bit compare: AND each 32-bit half with its neighbour. */
+    static inline __m128i private_vector_sse2_cmpeq_epi64(__m128i a, __m128i b)
+    {
+        __m128i c = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    #define private_vector_simd_mask_u8(p, k)  private_vector_simd_bytes(_mm_cmpeq_epi8(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u16(p, k) private_vector_simd_bytes(_mm_cmpeq_epi16(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u32(p, k) private_vector_simd_bytes(_mm_cmpeq_epi32(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_u64(p, k) private_vector_simd_bytes(private_vector_sse2_cmpeq_epi64(private_vector_simd_load(p), k))
+    #define private_vector_simd_mask_f32(p, k) private_vector_simd_bytes(_mm_castps_si128( \
+        _mm_cmpeq_ps(_mm_loadu_ps((const float *)(const void *)(p)), k)))
+    #define private_vector_simd_mask_f64(p, k) private_vector_simd_bytes(_mm_castpd_si128( \
+        _mm_cmpeq_pd(_mm_loadu_pd((const double *)(const void *)(p)), k)))
+#elif defined(VECTOR_SIMD_NEON)
+    #define VECTOR_SIMD_BYTES       16
+    #define VECTOR_SIMD_BITS(T)     (4 * sizeof(T))
+    #define private_vector_simd_key_u8(v)   vdupq_n_u8((uint8_t)(v))
+    #define private_vector_simd_key_u16(v)  vdupq_n_u16((uint16_t)(v))
+    #define private_vector_simd_key_u32(v)  vdupq_n_u32((uint32_t)(v))
+    #define private_vector_simd_key_u64(v)  vdupq_n_u64((uint64_t)(v))
+    #define private_vector_simd_key_f32(v)  vdupq_n_f32(v)
+    #define private_vector_simd_key_f64(v)  vdupq_n_f64(v)
+    /* Narrowing shift packs the 16 byte lanes into 16 nibbles of a 64-bit mask. */
+    #define private_vector_simd_bytes(c) \
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(c), 4)), 0)
+    #define private_vector_simd_mask_u8(p, k)  private_vector_simd_bytes(vceqq_u8(vld1q_u8((const uint8_t *)(const void *)(p)), k))
+    #define private_vector_simd_mask_u16(p, k) private_vector_simd_bytes(vreinterpretq_u8_u16(vceqq_u16(vld1q_u16((const uint16_t *)(const void *)(p)), k)))
+    #define private_vector_simd_mask_u32(p, k) private_vector_simd_bytes(vreinterpretq_u8_u32(vceqq_u32(vld1q_u32((const uint32_t *)(const void *)(p)), k)))
+    #define private_vector_simd_mask_u64(p, k) private_vector_simd_bytes(vreinterpretq_u8_u64(vceqq_u64(vld1q_u64((const uint64_t *)(const void *)(p)), k)))
+    #define private_vector_simd_mask_f32(p, k) private_vector_simd_bytes(vreinterpretq_u8_u32(vceqq_f32(vld1q_f32((const float *)(const void *)(p)), k)))
+    #define private_vector_simd_mask_f64(p, k) private_vector_simd_bytes(vreinterpretq_u8_u64(vceqq_f64(vld1q_f64((const double *)(const void *)(p)), k)))
+#endif
+
+typedef ptrdiff_t (*VectorFindKernel)(const void *data, size_t n, const void *value);
+typedef size_t    (*VectorCountKernel)(const void *data, size_t n, const void *value);
+
+typedef struct {
+    VectorFindKernel  find_first;
+    VectorFindKernel  find_last;
+    VectorCountKernel count;
+} VectorScanKernels;
+
+#ifdef VECTOR_SIMD_BYTES
+
+/* !! PRIVATE !! — Generates the find_first / find_last / count kernels for one element width */
+#define PRIVATE_VECTOR_SCAN_KERNELS(tag, T) \
+static inline ptrdiff_t private_vector_find_first_##tag(const void *data, size_t n, const void *value) \
+{ \
+    const unsigned char *p = (const unsigned char *)data; \
+    const size_t lanes = VECTOR_SIMD_BYTES / sizeof(T); \
+    T v; memcpy(&v, value, sizeof(T)); \
+    size_t i = 0; \
+    if (n >= lanes) { \
+        TYPE_OF(private_vector_simd_key_##tag(v)) k = private_vector_simd_key_##tag(v); \
+        for (; i + lanes <= n; i += lanes) { \
+            uint64_t m = private_vector_simd_mask_##tag(p + i * sizeof(T), k); \
+            if (m) return (ptrdiff_t)(i + VECTOR_CTZ64(m) / VECTOR_SIMD_BITS(T)); \
+        } \
+    } \
+    for (; i < n; ++i) { \
+        T x; memcpy(&x, p + i * sizeof(T), sizeof(T)); \
+        if (x == v) return (ptrdiff_t)i; \
+    } \
+    return -1; \
+} \
+static inline ptrdiff_t private_vector_find_last_##tag(const void *data, size_t n, const void *value) \
+{ \
+    const unsigned char *p = (const unsigned char *)data; \
+    const size_t lanes = VECTOR_SIMD_BYTES / sizeof(T); \
+    T v; memcpy(&v, value, sizeof(T)); \
+    size_t i = n; \
+    if (n >= lanes) { \
+        TYPE_OF(private_vector_simd_key_##tag(v)) k = private_vector_simd_key_##tag(v); \
+        for (; i >= lanes; i -= lanes) { \
+            uint64_t m = private_vector_simd_mask_##tag(p + (i - lanes) * sizeof(T), k); \
+            if (m) return (ptrdiff_t)(i - lanes + (63u - VECTOR_CLZ64(m)) / VECTOR_SIMD_BITS(T)); \
+        } \
+    } \
+    while (i-- > 0) { \
+        T x; memcpy(&x, p + i * sizeof(T), sizeof(T)); \
+        if (x == v) return (ptrdiff_t)i; \
+    } \
+    return -1; \
+} \
+static inline size_t private_vector_count_##tag(const void *data, size_t n, const void *value) \
+{ \
+    const unsigned char *p = (const unsigned char *)data; \
+    const size_t lanes = VECTOR_SIMD_BYTES / sizeof(T); \
+    T v; memcpy(&v, value, sizeof(T)); \
+    size_t i = 0, c = 0; \
+    if (n >= lanes) { \
+        TYPE_OF(private_vector_simd_key_##tag(v)) k = private_vector_simd_key_##tag(v); \
+        for (; i + lanes <= n; i += lanes) \
+            c += VECTOR_POPCOUNT64(private_vector_simd_mask_##tag(p + i * sizeof(T), k)); \
+        c /= VECTOR_SIMD_BITS(T); \
+    } \
+    for (; i < n; ++i) { \
+        T x; memcpy(&x, p + i * sizeof(T), sizeof(T)); \
+        c += (x == v); \
+    } \
+    return c; \
+} \
+static const VectorScanKernels private_vector_scan_##tag = { \
+    private_vector_find_first_##tag, private_vector_find_last_##tag, private_vector_count_##tag \
+};
+
+PRIVATE_VECTOR_SCAN_KERNELS(u8,  uint8_t)
+PRIVATE_VECTOR_SCAN_KERNELS(u16, uint16_t)
+PRIVATE_VECTOR_SCAN_KERNELS(u32, uint32_t)
+PRIVATE_VECTOR_SCAN_KERNELS(u64, uint64_t)
+PRIVATE_VECTOR_SCAN_KERNELS(f32, float)
+PRIVATE_VECTOR_SCAN_KERNELS(f64, double)
+
+/* !! PRIVATE !! — Integer kernels are picked by width; signedness does not matter for == */
+#define private_vector_int_scan(T) \
+    (sizeof(T) == 1 ? &private_vector_scan_u8  : sizeof(T) == 2 ? &private_vector_scan_u16 : \
+     sizeof(T) == 4 ? &private_vector_scan_u32 : &private_vector_scan_u64)
+
+#ifdef __cplusplus
+    template <typename T>
+    inline const VectorScanKernels *private_vector_scan_kernels(const T *) { return nullptr; }
+    inline const VectorScanKernels *private_vector_scan_kernels(const char *)               { return private_vector_int_scan(char); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const signed char *)        { return private_vector_int_scan(signed char); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const unsigned char *)      { return private_vector_int_scan(unsigned char); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const short *)              { return private_vector_int_scan(short); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const unsigned short *)     { return private_vector_int_scan(unsigned short); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const int *)                { return private_vector_int_scan(int); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const unsigned int *)       { return private_vector_int_scan(unsigned int); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const long *)               { return private_vector_int_scan(long); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const unsigned long *)      { return private_vector_int_scan(unsigned long); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const long long *)          { return private_vector_int_scan(long long); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const unsigned long long *) { return private_vector_int_scan(unsigned long long); }
+    inline const VectorScanKernels *private_vector_scan_kernels(const float *)              { return &private_vector_scan_f32; }
+    inline const VectorScanKernels *private_vector_scan_kernels(const double *)             { return &private_vector_scan_f64; }
+#else
+    #define private_vector_scan_kernels(ptr) _Generic(*(ptr), \
+        char:               private_vector_int_scan(char), \
+        signed char:        private_vector_int_scan(signed char), \
+        unsigned char:      private_vector_int_scan(unsigned char), \
+        short:              private_vector_int_scan(short), \
+        unsigned short:     private_vector_int_scan(unsigned short), \
+        int:                private_vector_int_scan(int), \
+        unsigned int:       private_vector_int_scan(unsigned int), \
+        long:               private_vector_int_scan(long), \
+        unsigned long:      private_vector_int_scan(unsigned long), \
+        long long:          private_vector_int_scan(long long), \
+        unsigned long long: private_vector_int_scan(unsigned long long), \
+        float:              &private_vector_scan_f32, \
+        double:             &private_vector_scan_f64, \
+        default:            (const VectorScanKernels *)NULL_PTR)
+#endif
+
+#else  /* no SIMD: every type takes the scalar path */
+    #define private_vector_scan_kernels(ptr) ((const VectorScanKernels *)NULL_PTR)
+#endif /* VECTOR_SIMD_BYTES */
+
 /** 
  * Searches using a custom comparison predicate.
  * Optimized with 4-step loop unrolling.
@@ -463,8 +1735,8 @@ typedef struct {
  */
 #define vector_find_custom(vec, value, cmp_func) ({ \
     ptrdiff_t _result = -1; \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: Vector not initialized before 'vector_find_custom' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: Vector not initialized before 'vector_find_custom'", __FILE__, __LINE__); \
     } else { \
         TYPE_OF_VAL(*(vec).data) _search_val = (value); \
         size_t _sz = (vec).size; \
@@ -488,7 +1760,8 @@ typedef struct {
 })
 
 /** 
- * Searches using == operator. Optimized with 4-step loop unrolling.
+ * Searches using == operator. Integer and floating-point elements use the SIMD
+ * scan kernels; other scalar types fall back to a 4-step unrolled loop.
  * @note Only valid for scalar types (int, float, pointer, enum).
  *       Do NOT use with structs or strings — use vector_find_custom instead.
  * @return Index of first match, or -1 if not found.
@@ -497,8 +1770,11 @@ typedef struct {
  */
 #define vector_find(vec, value) ({ \
     ptrdiff_t _result = -1; \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: Vector not initialized before 'vector_find' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: Vector not initialized before 'vector_find'", __FILE__, __LINE__); \
+    } else if (private_vector_scan_kernels((vec).data) != NULL_PTR) { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        _result = private_vector_scan_kernels((vec).data)->find_first((vec).data, (vec).size, &_search_val); \
     } else { \
         TYPE_OF_VAL(*(vec).data) _search_val = (value); \
         size_t _i  = 0; \
@@ -521,25 +1797,66 @@ typedef struct {
     _result; \
 })
 
+/**
+ * Searches backwards using == operator (SIMD-accelerated like vector_find).
+ * @return Index of the last match, or -1 if not found.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_find_last(vec, value) ({ \
+    ptrdiff_t _result = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: Vector not initialized before 'vector_find_last'", __FILE__, __LINE__); \
+    } else if (private_vector_scan_kernels((vec).data) != NULL_PTR) { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        _result = private_vector_scan_kernels((vec).data)->find_last((vec).data, (vec).size, &_search_val); \
+    } else { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        for (size_t _i = (vec).size; _i-- > 0; ) { \
+            if ((vec).data[_i] == _search_val) { \
+                _result = (ptrdiff_t)_i; \
+                break; \
+            } \
+        } \
+    } \
+    _result; \
+})
+
+/**
+ * Counts the elements equal to value using == operator (SIMD-accelerated like vector_find).
+ * @return Number of matches (size_t), 0 if the vector is uninitialized.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_count(vec, value) ({ \
+    size_t _count = 0; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: Vector not initialized before 'vector_count'", __FILE__, __LINE__); \
+    } else if (private_vector_scan_kernels((vec).data) != NULL_PTR) { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        _count = private_vector_scan_kernels((vec).data)->count((vec).data, (vec).size, &_search_val); \
+    } else { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        for (size_t _i = 0; _i < (vec).size; ++_i) \
+            _count += ((vec).data[_i] == _search_val); \
+    } \
+    _count; \
+})
+
 /* !! PRIVATE !! — Do not call directly */
 static inline int private_vector_push_back_args_inline
 (
     void *vec_ptr, size_t elem_size,
-    const void *elems, size_t count
+    const void *elems, size_t count,
+    const char *file, int line
 ) 
 
 {
     VectorBase *vec = (VectorBase *)vec_ptr;
-    if (UNLIKELY(vec->magic != VECTOR_MAGIC_INIT)) return -1;
+    if (UNLIKELY(!vector_is_valid(*vec))) return -1;
     size_t new_size = vec->size + count;
-    if (UNLIKELY(new_size > vec->capacity)) {
-        size_t nc = vec->capacity == 0 ? (count < 4 ? 4 : count) : vec->capacity;
-        while (nc < new_size) nc <<= 1;
-        void *nd = CLIB_PREFIX realloc(vec->data, nc * elem_size);
-        if (UNLIKELY(nd == NULL_PTR)) return -1;
-        vec->data     = nd;
-        vec->capacity = nc;
-    }
+    if (UNLIKELY(new_size > vec->capacity) &&
+        private_vector_grow_base(vec, elem_size, new_size, NULL_PTR, file, line) != 0) return -1;
     memcpy((char *)vec->data + vec->size * elem_size, elems, count * elem_size);
     vec->size = new_size;
     return 0;
@@ -554,8 +1871,8 @@ static inline int private_vector_push_back_args_inline
 #define vector_push_back_args(vec, ...) do { \
     TYPE_OF_VAL(*(vec).data) _tmp[] = { __VA_ARGS__ }; \
     if (private_vector_push_back_args_inline(&(vec), sizeof(*(vec).data), _tmp, \
-                                             sizeof(_tmp) / sizeof(_tmp[0])) != 0) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: 'vector_push_back_args' failed at %s:%d\n", __FILE__, __LINE__); \
+                                             sizeof(_tmp) / sizeof(_tmp[0]), __FILE__, __LINE__) != 0) { \
+        private_vector_fail("[x] Error: 'vector_push_back_args' failed", __FILE__, __LINE__); \
     } \
 } while(0)
 
@@ -567,25 +1884,18 @@ static inline int private_vector_push_back_args_inline
  * @param value    Element to insert.
  */
 #define vector_insert(vec, position, value) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_insert' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_insert'", __FILE__, __LINE__); \
         break; \
     } \
     size_t _pos = (size_t)(position); \
-    if (UNLIKELY(_pos > (vec).size)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: insert position out of bounds in 'vector_insert' at %s:%d\n", __FILE__, __LINE__); \
+    if (VECTOR_CHECK(_pos > (vec).size)) { \
+        private_vector_fail("[x] Error: insert position out of bounds in 'vector_insert'", __FILE__, __LINE__); \
         break; \
     } \
-    if (UNLIKELY((vec).size >= (vec).capacity)) { \
-        size_t _nc = VECTOR_GROW_CAPACITY((vec).capacity); \
-        TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, _nc * sizeof(*(vec).data)); \
-        if (UNLIKELY(_nd == NULL_PTR)) { \
-            CLIB_PREFIX fprintf(stderr, "[x] Error: allocation failed in 'vector_insert' at %s:%d\n", __FILE__, __LINE__); \
-            break; \
-        } \
-        (vec).data     = _nd; \
-        (vec).capacity = _nc; \
-    } \
+    if (UNLIKELY((vec).size >= (vec).capacity) && \
+        private_vector_grow_base(&(vec), sizeof(*(vec).data), (vec).size + 1, \
+            "[x] Error: allocation failed in 'vector_insert'", __FILE__, __LINE__) != 0) break; \
     if (_pos < (vec).size) \
         memmove(&(vec).data[_pos + 1], &(vec).data[_pos], ((vec).size - _pos) * sizeof(*(vec).data)); \
     (vec).data[_pos] = (value); \
@@ -597,33 +1907,25 @@ static inline int private_vector_push_back_args_inline
  * @note O(N) due to memmove + memcpy.
  */
 #define vector_insert_range(vec, pos, arr, count) do { \
-    if (UNLIKELY((vec).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector not initialized before 'vector_insert_range' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_insert_range'", __FILE__, __LINE__); \
         break; \
     } \
-    if (UNLIKELY((arr) == NULL_PTR)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: source array is NULL in 'vector_insert_range' at %s:%d\n", __FILE__, __LINE__); \
+    if (VECTOR_CHECK((arr) == NULL_PTR)) { \
+        private_vector_fail("[x] Error: source array is NULL in 'vector_insert_range'", __FILE__, __LINE__); \
         break; \
     } \
     size_t _pos = (size_t)(pos); \
     size_t _cnt = (size_t)(count); \
-    if (UNLIKELY(_pos > (vec).size)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: insert position out of bounds in 'vector_insert_range' at %s:%d\n", __FILE__, __LINE__); \
+    if (VECTOR_CHECK(_pos > (vec).size)) { \
+        private_vector_fail("[x] Error: insert position out of bounds in 'vector_insert_range'", __FILE__, __LINE__); \
         break; \
     } \
     if (_cnt == 0) break; \
     size_t _ns = (vec).size + _cnt; \
-    if (_ns > (vec).capacity) { \
-        size_t _nc = VECTOR_GROW_CAPACITY((vec).capacity); \
-        if (_nc < _ns) _nc = _ns; \
-        TYPE_OF((vec).data) _nd = (TYPE_OF((vec).data))CLIB_PREFIX realloc((vec).data, _nc * sizeof(*(vec).data)); \
-        if (UNLIKELY(_nd == NULL_PTR)) { \
-            CLIB_PREFIX fprintf(stderr, "[x] Error: allocation failed in 'vector_insert_range' at %s:%d\n", __FILE__, __LINE__); \
-            break; \
-        } \
-        (vec).data     = _nd; \
-        (vec).capacity = _nc; \
-    } \
+    if (_ns > (vec).capacity && \
+        private_vector_grow_base(&(vec), sizeof(*(vec).data), _ns, \
+            "[x] Error: allocation failed in 'vector_insert_range'", __FILE__, __LINE__) != 0) break; \
     if (_pos < (vec).size) \
         memmove(&(vec).data[_pos + _cnt], &(vec).data[_pos], ((vec).size - _pos) * sizeof(*(vec).data)); \
     memcpy(&(vec).data[_pos], (arr), _cnt * sizeof(*(vec).data)); \
@@ -635,22 +1937,17 @@ static inline int private_vector_insert_args_inline
 (
     void *vec_ptr, size_t elem_size,
     size_t index,
-    const void *elems, size_t count
+    const void *elems, size_t count,
+    const char *file, int line
 ) 
 
 {
     VectorBase *vec = (VectorBase *)vec_ptr;
-    if (UNLIKELY(vec->magic != VECTOR_MAGIC_INIT)) return -1;
-    if (UNLIKELY(index > vec->size))               return -1;
+    if (UNLIKELY(!vector_is_valid(*vec))) return -1;
+    if (VECTOR_CHECK(index > vec->size))               return -1;
     size_t new_size = vec->size + count;
-    if (UNLIKELY(new_size > vec->capacity)) {
-        size_t nc = vec->capacity == 0 ? (count < 4 ? 4 : count) : vec->capacity;
-        while (nc < new_size) nc <<= 1;
-        void *nd = CLIB_PREFIX realloc(vec->data, nc * elem_size);
-        if (UNLIKELY(nd == NULL_PTR)) return -1;
-        vec->data     = nd;
-        vec->capacity = nc;
-    }
+    if (UNLIKELY(new_size > vec->capacity) &&
+        private_vector_grow_base(vec, elem_size, new_size, NULL_PTR, file, line) != 0) return -1;
     memmove(
         (char *)vec->data + (index + count) * elem_size,
         (char *)vec->data + index * elem_size,
@@ -667,9 +1964,101 @@ static inline int private_vector_insert_args_inline
 #define vector_insert_args(vec, idx, ...) do { \
     TYPE_OF_VAL(*(vec).data) _tmp[] = { __VA_ARGS__ }; \
     if (private_vector_insert_args_inline(&(vec), sizeof(*(vec).data), (idx), _tmp, \
-                                          sizeof(_tmp) / sizeof(_tmp[0])) != 0) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: vector_insert_args failed at %s:%d\n", __FILE__, __LINE__); \
+                                          sizeof(_tmp) / sizeof(_tmp[0]), __FILE__, __LINE__) != 0) { \
+        private_vector_fail("[x] Error: vector_insert_args failed", __FILE__, __LINE__); \
+    } \
+} while(0)
+
+/**
+ * Removes the element at position, shifting subsequent elements left.
+ * @note O(N) complexity due to memmove. Use vector_swap_remove if order does not matter.
+ * @param vec      The vector to modify.
+ * @param position Index of the element to remove (0 to size - 1).
+ */
+#define vector_erase(vec, position) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_erase'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _pos = (size_t)(position); \
+    if (VECTOR_CHECK(_pos >= (vec).size)) { \
+        private_vector_fail("[x] Error: erase position out of bounds in 'vector_erase'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (_pos + 1 < (vec).size) \
+        memmove(&(vec).data[_pos], &(vec).data[_pos + 1], ((vec).size - _pos - 1) * sizeof(*(vec).data)); \
+    (vec).size--; \
+} while(0)
+
+/**
+ * Removes count elements starting at first, shifting the tail left once.
+ * @note O(N) due to a single memmove.
+ * @param vec   The vector to modify.
+ * @param first Index of the first element to remove.
+ * @param count Number of elements to remove (first + count must not exceed size).
+ */
+#define vector_erase_range(vec, first, count) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_erase_range'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _first = (size_t)(first); \
+    size_t _cnt   = (size_t)(count); \
+    if (VECTOR_CHECK(_first > (vec).size || _cnt > (vec).size - _first)) { \
+        private_vector_fail("[x] Error: erase range out of bounds in 'vector_erase_range'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (_cnt == 0) break; \
+    if (_first + _cnt < (vec).size) \
+        memmove(&(vec).data[_first], &(vec).data[_first + _cnt], \
+                ((vec).size - _first - _cnt) * sizeof(*(vec).data)); \
+    (vec).size -= _cnt; \
+} while(0)
+
+/**
+ * Removes the element at position in O(1) by moving the last element into its slot.
+ * @note Does NOT preserve element order.
+ * @param vec      The vector to modify.
+ * @param position Index of the element to remove (0 to size - 1).
+ */
+#define vector_swap_remove(vec, position) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_swap_remove'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _pos = (size_t)(position); \
+    if (VECTOR_CHECK(_pos >= (vec).size)) { \
+        private_vector_fail("[x] Error: position out of bounds in 'vector_swap_remove'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (vec).data[_pos] = (vec).data[--(vec).size]; \
+} while(0)
+
+/* !! PRIVATE !! — Single-pass in-place compaction; `remove_expr` may use the index `_i` */
+#define private_vector_remove_where(vec, remove_expr) do { \
+    size_t _w  = 0; \
+    size_t _sz = (vec).size; \
+    for (size_t _i = 0; _i < _sz; ++_i) { \
+        if (!(remove_expr)) { \
+            if (_w != _i) (vec).data[_w] = (vec).data[_i]; \
+            _w++; \
+        } \
+    } \
+    (vec).size = _w; \
+} while(0)
+
+/**
+ * Removes every element for which pred(element) is nonzero, compacting in a single O(N) pass.
+ * Relative order of the kept elements is preserved. Capacity is unchanged.
+ * @param vec  The vector to modify.
+ * @param pred Predicate function or macro: pred(item) -> nonzero to remove.
+ */
+#define vector_remove_if(vec, pred) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_remove_if'", __FILE__, __LINE__); \
+        break; \
     } \
+    private_vector_remove_where(vec, pred((vec).data[_i])); \
 } while(0)
 
 /** 
@@ -678,18 +2067,349 @@ static inline int private_vector_insert_args_inline
  */
 #define vector_swap(vec1, vec2) do { \
     VECTOR_ASSERT_SAME_TYPE(vec1, vec2); \
-    if (UNLIKELY((vec1).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: first vector not initialized before 'vector_swap' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec1))) { \
+        private_vector_fail("[x] Error: first vector not initialized before 'vector_swap'", __FILE__, __LINE__); \
         break; \
     } \
-    if (UNLIKELY((vec2).magic != VECTOR_MAGIC_INIT)) { \
-        CLIB_PREFIX fprintf(stderr, "[x] Error: second vector not initialized before 'vector_swap' at %s:%d\n", __FILE__, __LINE__); \
+    if (UNLIKELY(!vector_is_valid(vec2))) { \
+        private_vector_fail("[x] Error: second vector not initialized before 'vector_swap'", __FILE__, __LINE__); \
         break; \
     } \
     TYPE_OF((vec1).data) _td = (vec1).data;     (vec1).data     = (vec2).data;     (vec2).data     = _td; \
     size_t               _ts = (vec1).size;     (vec1).size     = (vec2).size;     (vec2).size     = _ts; \
     size_t               _tc = (vec1).capacity; (vec1).capacity = (vec2).capacity; (vec2).capacity = _tc; \
+    const VectorAllocator *_ta = (vec1).allocator; (vec1).allocator = (vec2).allocator; (vec2).allocator = _ta; \
     \
 } while(0)
 
+/**
+ * @section Sorting and Searching
+ * -------------------------------------------------------------------------
+ * vector_sort dispatches on the element type like the scan kernels:
+ * 8/16/32/64-bit integers, float and double take an LSD radix sort (one
+ * histogram pass, then one scatter pass per key byte, skipping bytes that are
+ * equal in every key). Short vectors, and element types without a radix path,
+ * use an introsort with `<`. The position of NaNs in a sorted float vector is
+ * unspecified.
+ *
+ * vector_sort_custom takes a `less(a, b)` function or macro the same way
+ * vector_find_custom takes `cmp_func`; it is expanded inside the sort loop, so
+ * there is no indirect call per comparison. The introsort (median-of-three
+ * quicksort, heapsort past 2*log2(n) levels, insertion sort below 16
+ * elements) is not stable.
+ *
+ * The bound/search macros expect a vector sorted by the same ordering.
+ */
+#ifndef VECTOR_SORT_RADIX_MIN
+    #define VECTOR_SORT_RADIX_MIN 256       /* below this, vector_sort uses introsort */
+#endif
+
+#define PRIVATE_VECTOR_KEY_NONE     0
+#define PRIVATE_VECTOR_KEY_UNSIGNED 1
+#define PRIVATE_VECTOR_KEY_SIGNED   2
+#define PRIVATE_VECTOR_KEY_FLOAT    3
+
+/* !! PRIVATE !! — Radix key kind of an integer type */
+#define private_vector_int_key(T) \
+    ((T)-1 < (T)1 ? PRIVATE_VECTOR_KEY_SIGNED : PRIVATE_VECTOR_KEY_UNSIGNED)
+
+#ifdef __cplusplus
+    template <typename T>
+    inline int private_vector_sort_key(const T *) { return PRIVATE_VECTOR_KEY_NONE; }
+    inline int private_vector_sort_key(const char *)               { return private_vector_int_key(char); }
+    inline int private_vector_sort_key(const signed char *)        { return private_vector_int_key(signed char); }
+    inline int private_vector_sort_key(const unsigned char *)      { return private_vector_int_key(unsigned char); }
+    inline int private_vector_sort_key(const short *)              { return private_vector_int_key(short); }
+    inline int private_vector_sort_key(const unsigned short *)     { return private_vector_int_key(unsigned short); }
+    inline int private_vector_sort_key(const int *)                { return private_vector_int_key(int); }
+    inline int private_vector_sort_key(const unsigned int *)       { return private_vector_int_key(unsigned int); }
+    inline int private_vector_sort_key(const long *)               { return private_vector_int_key(long); }
+    inline int private_vector_sort_key(const unsigned long *)      { return private_vector_int_key(unsigned long); }
+    inline int private_vector_sort_key(const long long *)          { return private_vector_int_key(long long); }
+    inline int private_vector_sort_key(const unsigned long long *) { return private_vector_int_key(unsigned long long); }
+    inline int private_vector_sort_key(const float *)              { return PRIVATE_VECTOR_KEY_FLOAT; }
+    inline int private_vector_sort_key(const double *)             { return PRIVATE_VECTOR_KEY_FLOAT; }
+#else
+    #define private_vector_sort_key(ptr) _Generic(*(ptr), \
+        char:               private_vector_int_key(char), \
+        signed char:        private_vector_int_key(signed char), \
+        unsigned char:      private_vector_int_key(unsigned char), \
+        short:              private_vector_int_key(short), \
+        unsigned short:     private_vector_int_key(unsigned short), \
+        int:                private_vector_int_key(int), \
+        unsigned int:       private_vector_int_key(unsigned int), \
+        long:               private_vector_int_key(long), \
+        unsigned long:      private_vector_int_key(unsigned long), \
+        long long:          private_vector_int_key(long long), \
+        unsigned long long: private_vector_int_key(unsigned long long), \
+        float:              PRIVATE_VECTOR_KEY_FLOAT, \
+        double:             PRIVATE_VECTOR_KEY_FLOAT, \
+        default:            PRIVATE_VECTOR_KEY_NONE)
+#endif
+
+/*
+ * !! PRIVATE !! — Generates the LSD radix sort for one key width.
+ * Keys are mapped to unsigned order with key = bits ^ flip, where flip is the
+ * sign bit for signed integers, and for floats the sign bit (positive) or all
+ * bits (negative). Elements are loaded and stored with memcpy (plain moves once
+ * optimized), so float/double/long data is never accessed through uintN_t lvalues.
+ */
+#define PRIVATE_VECTOR_RADIX_SORT(bits) \
+static inline uint##bits##_t private_vector_radix_load_##bits(const unsigned char *p, size_t i) \
+{ \
+    uint##bits##_t x; \
+    memcpy(&x, p + i * sizeof(x), sizeof(x)); \
+    return x; \
+} \
+\
+static inline void private_vector_radix_sort_##bits \
+( \
+    unsigned char *data, unsigned char *tmp, \
+    size_t n, int kind \
+) \
+{ \
+    const uint##bits##_t sign     = (uint##bits##_t)((uint##bits##_t)1 << (bits - 1)); \
+    const uint##bits##_t flip     = kind == PRIVATE_VECTOR_KEY_UNSIGNED ? (uint##bits##_t)0 : sign; \
+    const uint##bits##_t neg_mask = kind == PRIVATE_VECTOR_KEY_FLOAT ? (uint##bits##_t)~(uint##bits##_t)0 : (uint##bits##_t)0; \
+    size_t counts[bits / 8][256]; \
+    memset(counts, 0, sizeof(counts)); \
+    for (size_t i = 0; i < n; i++) { \
+        uint##bits##_t x = private_vector_radix_load_##bits(data, i); \
+        uint##bits##_t k = x ^ (flip | (neg_mask & (uint##bits##_t)(0 - (x >> (bits - 1))))); \
+        for (unsigned b = 0; b < bits / 8; b++) counts[b][(k >> (8 * b)) & 0xFF]++; \
+    } \
+    unsigned char *src = data, *dst = tmp; \
+    for (unsigned b = 0; b < bits / 8; b++) { \
+        size_t *c = counts[b]; \
+        uint##bits##_t x0 = private_vector_radix_load_##bits(src, 0); \
+        uint##bits##_t k0 = x0 ^ (flip | (neg_mask & (uint##bits##_t)(0 - (x0 >> (bits - 1))))); \
+        if (c[(k0 >> (8 * b)) & 0xFF] == n) continue;  /* every key shares this byte */ \
+        size_t sum = 0; \
+        for (unsigned d = 0; d < 256; d++) { size_t t = c[d]; c[d] = sum; sum += t; } \
+        for (size_t i = 0; i < n; i++) { \
+            uint##bits##_t x = private_vector_radix_load_##bits(src, i); \
+            uint##bits##_t k = x ^ (flip | (neg_mask & (uint##bits##_t)(0 - (x >> (bits - 1))))); \
+            memcpy(dst + c[(k >> (8 * b)) & 0xFF]++ * sizeof(x), &x, sizeof(x)); \
+        } \
+        unsigned char *t = src; src = dst; dst = t; \
+    } \
+    if (src != data) memcpy(data, src, n * sizeof(uint##bits##_t)); \
+}
+
+PRIVATE_VECTOR_RADIX_SORT(8)
+PRIVATE_VECTOR_RADIX_SORT(16)
+PRIVATE_VECTOR_RADIX_SORT(32)
+PRIVATE_VECTOR_RADIX_SORT(64)
+
+/* !! PRIVATE !! — Radix-sorts n keys of elem_size bytes; returns -1 if the scratch buffer cannot be allocated */
+static inline int private_vector_radix_sort(void *data, size_t n, size_t elem_size, int kind)
+{
+    unsigned char *tmp = (unsigned char *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, n * elem_size);
+    if (UNLIKELY(tmp == NULL_PTR)) return -1;
+    switch (elem_size) {
+        case 1:  private_vector_radix_sort_8 ((unsigned char *)data, tmp, n, kind); break;
+        case 2:  private_vector_radix_sort_16((unsigned char *)data, tmp, n, kind); break;
+        case 4:  private_vector_radix_sort_32((unsigned char *)data, tmp, n, kind); break;
+        default: private_vector_radix_sort_64((unsigned char *)data, tmp, n, kind); break;
+    }
+    private_vector_free(NULL_PTR, tmp, n * elem_size);
+    return 0;
+}
+
+/* !! PRIVATE !! — Default ordering for vector_sort / vector_*_bound */
+#define PRIVATE_VECTOR_LESS(a, b) ((a) < (b))
+
+/* !! PRIVATE !! — Swaps two elements of a vector's element type */
+#define PRIVATE_VECTOR_SWAP(T, x, y) do { T _sw = (x); (x) = (y); (y) = _sw; } while(0)
+
+/* !! PRIVATE !! — Heap sift-down of h[root] within h[0, end) */
+#define PRIVATE_VECTOR_SIFT_DOWN(T, h, root, end, less) do { \
+    size_t _r = (root); \
+    for (;;) { \
+        size_t _c = 2 * _r + 1; \
+        if (_c >= (end)) break; \
+        if (_c + 1 < (end) && less((h)[_c], (h)[_c + 1])) _c++; \
+        if (!less((h)[_r], (h)[_c])) break; \
+        PRIVATE_VECTOR_SWAP(T, (h)[_r], (h)[_c]); \
+        _r = _c; \
+    } \
+} while(0)
+
+/* !! PRIVATE !! — In-place introsort of a[0, n) by less(x, y); iterative, O(log n) stack */
+#define PRIVATE_VECTOR_INTROSORT(a, n, less) do { \
+    typedef TYPE_OF_VAL(*(a)) _elem_t; \
+    _elem_t      *_arr = (a); \
+    size_t   _stk_lo[64], _stk_hi[64]; \
+    unsigned _stk_depth[64]; \
+    int      _sp = 0; \
+    size_t   _lo = 0, _hi = (n); \
+    unsigned _depth = 2 * (64 - VECTOR_CLZ64((uint64_t)_hi | 1)); \
+    for (;;) { \
+        size_t _len = _hi - _lo; \
+        if (_len <= 16 || _depth == 0) { \
+            if (_len <= 16) { \
+                for (size_t _i = _lo + 1; _i < _hi; _i++) { \
+                    _elem_t _key = _arr[_i]; \
+                    size_t _j = _i; \
+                    for (; _j > _lo && less(_key, _arr[_j - 1]); _j--) _arr[_j] = _arr[_j - 1]; \
+                    _arr[_j] = _key; \
+                } \
+            } else { \
+                _elem_t *_h = _arr + _lo; \
+                for (size_t _s = _len / 2; _s-- > 0; ) PRIVATE_VECTOR_SIFT_DOWN(_elem_t, _h, _s, _len, less); \
+                for (size_t _e = _len; _e-- > 1; ) { \
+                    PRIVATE_VECTOR_SWAP(_elem_t, _h[0], _h[_e]); \
+                    PRIVATE_VECTOR_SIFT_DOWN(_elem_t, _h, 0, _e, less); \
+                } \
+            } \
+            if (_sp == 0) break; \
+            --_sp; \
+            _lo = _stk_lo[_sp]; _hi = _stk_hi[_sp]; _depth = _stk_depth[_sp]; \
+            continue; \
+        } \
+        _depth--; \
+        size_t _m = _lo + (_len - 1) / 2; \
+        if (less(_arr[_m], _arr[_lo]))      PRIVATE_VECTOR_SWAP(_elem_t, _arr[_m], _arr[_lo]); \
+        if (less(_arr[_hi - 1], _arr[_m])) { \
+            PRIVATE_VECTOR_SWAP(_elem_t, _arr[_hi - 1], _arr[_m]); \
+            if (less(_arr[_m], _arr[_lo]))  PRIVATE_VECTOR_SWAP(_elem_t, _arr[_m], _arr[_lo]); \
+        } \
+        _elem_t _pivot = _arr[_m]; \
+        size_t _i = _lo - 1, _j = _hi; \
+        for (;;) { \
+            do { _i++; } while (less(_arr[_i], _pivot)); \
+            do { _j--; } while (less(_pivot, _arr[_j])); \
+            if (_i >= _j) break; \
+            PRIVATE_VECTOR_SWAP(_elem_t, _arr[_i], _arr[_j]); \
+        } \
+        /* [_lo, _j] <= pivot <= [_j + 1, _hi): recurse into the smaller side, push the larger. */ \
+        size_t _mid = _j + 1; \
+        if (_mid - _lo < _hi - _mid) { \
+            _stk_lo[_sp] = _mid; _stk_hi[_sp] = _hi; _stk_depth[_sp] = _depth; _sp++; \
+            _hi = _mid; \
+        } else { \
+            _stk_lo[_sp] = _lo; _stk_hi[_sp] = _mid; _stk_depth[_sp] = _depth; _sp++; \
+            _lo = _mid; \
+        } \
+    } \
+} while(0)
+
+/**
+ * Sorts the vector in ascending order.
+ * @note Integers, float and double use LSD radix sort (O(N), needs an N-element scratch buffer);
+ *       other types with a `<` operator use introsort. Structs need vector_sort_custom.
+ * @param vec The vector to sort.
+ */
+#define vector_sort(vec) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_sort'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((vec).size < 2) break; \
+    int _kind = private_vector_sort_key((vec).data); \
+    if (_kind != PRIVATE_VECTOR_KEY_NONE && (vec).size >= VECTOR_SORT_RADIX_MIN && \
+        private_vector_radix_sort((vec).data, (vec).size, sizeof(*(vec).data), _kind) == 0) \
+        break; \
+    PRIVATE_VECTOR_INTROSORT((vec).data, (vec).size, PRIVATE_VECTOR_LESS); \
+} while(0)
+
+/**
+ * Sorts the vector with a custom ordering (introsort, not stable).
+ * @param vec  The vector to sort.
+ * @param less Function or macro: less(a, b) -> nonzero if a must come before b.
+ */
+#define vector_sort_custom(vec, less) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_sort_custom'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((vec).size < 2) break; \
+    PRIVATE_VECTOR_INTROSORT((vec).data, (vec).size, less); \
+} while(0)
+
+/*
+ * !! PRIVATE !! — Branchless binary search: first index whose element does not satisfy
+ * `before_expr`, which may use `*_xp` (the element) and `_key` (the searched value).
+ */
+#define private_vector_partition_point(vec, value, before_expr) ({ \
+    TYPE_OF_VAL(*(vec).data) _key = (value); \
+    TYPE_OF((vec).data) _base = (vec).data; \
+    size_t _len = (vec).size; \
+    while (_len > 1) { \
+        size_t _half = _len >> 1; \
+        TYPE_OF((vec).data) _xp = _base + _half - 1; \
+        _base = (before_expr) ? _base + _half : _base; \
+        _len -= _half; \
+    } \
+    size_t _pp = (size_t)(_base - (vec).data); \
+    if (_len == 1) { \
+        TYPE_OF((vec).data) _xp = _base; \
+        _pp += (before_expr) ? 1 : 0; \
+    } \
+    _pp; \
+})
+
+/**
+ * Index of the first element not less than value (size if none). Vector must be sorted.
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_lower_bound(vec, value) \
+    vector_lower_bound_custom(vec, value, PRIVATE_VECTOR_LESS)
+
+/**
+ * Index of the first element greater than value (size if none). Vector must be sorted.
+ */
+#define vector_upper_bound(vec, value) \
+    vector_upper_bound_custom(vec, value, PRIVATE_VECTOR_LESS)
+
+/**
+ * Index of an element equal to value, or -1. Vector must be sorted. O(log N).
+ */
+#define vector_binary_search(vec, value) \
+    vector_binary_search_custom(vec, value, PRIVATE_VECTOR_LESS)
+
+/**
+ * vector_lower_bound with a custom ordering: less(a, b) as in vector_sort_custom.
+ * @return size_t index; 0 if the vector is uninitialized.
+ */
+#define vector_lower_bound_custom(vec, value, less) ({ \
+    size_t _lb = 0; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_lower_bound'", __FILE__, __LINE__); \
+    } else { \
+        _lb = private_vector_partition_point(vec, value, less(*_xp, _key)); \
+    } \
+    _lb; \
+})
+
+/**
+ * vector_upper_bound with a custom ordering.
+ * @return size_t index; 0 if the vector is uninitialized.
+ */
+#define vector_upper_bound_custom(vec, value, less) ({ \
+    size_t _ub = 0; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_upper_bound'", __FILE__, __LINE__); \
+    } else { \
+        _ub = private_vector_partition_point(vec, value, !less(_key, *_xp)); \
+    } \
+    _ub; \
+})
+
+/**
+ * vector_binary_search with a custom ordering; equality means !less(a, b) && !less(b, a).
+ * @return ptrdiff_t index of the first equal element, or -1.
+ */
+#define vector_binary_search_custom(vec, value, less) ({ \
+    ptrdiff_t _found = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_binary_search'", __FILE__, __LINE__); \
+    } else { \
+        TYPE_OF_VAL(*(vec).data) _bkey = (value); \
+        size_t _at = private_vector_partition_point(vec, _bkey, less(*_xp, _key)); \
+        if (_at < (vec).size && !less(_bkey, (vec).data[_at])) _found = (ptrdiff_t)_at; \
+    } \
+    _found; \
+})
+
 #endif /* VECTOR_H */
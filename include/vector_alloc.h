@@ -0,0 +1,355 @@
+/*!
+    @file vector_alloc.h header file
+    @brief  arena and pool allocators for vector.h.
+
+    Both allocators plug into the VectorAllocator hook declared in vector.h.
+    Attach one with `vector_init_with_allocator(vec, vector_arena_allocator(&arena))`
+    and every growth, shrink and destroy call on that vector is served by it.
+
+    @details
+    - VectorArena: bump allocator over a chain of blocks. The most recent
+      allocation grows and shrinks in place; `vector_arena_reset` releases
+      every vector built on the arena in O(blocks).
+    - VectorPool:  power-of-two size classes with per-class free lists carved
+      from slabs. Blocks above the largest class are tracked individually.
+      `vector_pool_reset` releases everything at once.
+
+    @warning
+    - Neither allocator is thread-safe. Use one arena/pool per thread.
+    - After a reset, vectors that used the allocator hold dangling pointers.
+      Do NOT call `vector_destroy` on them; re-initialize or drop them.
+*/
+
+#ifndef VECTOR_ALLOC_H
+#define VECTOR_ALLOC_H
+
+#include "vector.h"
+
+/**
+ * @section Bump Arena
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef VECTOR_ARENA_DEFAULT_BLOCK
+    #define VECTOR_ARENA_DEFAULT_BLOCK (64u * 1024u)
+#endif
+
+/* Every arena allocation is rounded up to this many bytes. */
+#define VECTOR_ARENA_ALIGN 16u
+
+typedef struct VectorArenaBlock {
+    struct VectorArenaBlock *next;
+    size_t                   capacity;
+    size_t                   used;
+    size_t                   _pad;      /* keeps the payload 16-byte aligned */
+} VectorArenaBlock;
+
+typedef struct {
+    VectorAllocator   allocator;
+    VectorArenaBlock *head;             /* block currently being bumped */
+    VectorArenaBlock *spare;            /* blocks kept by reset, reused before malloc */
+    size_t            block_size;
+    void             *last;             /* most recent allocation, growable in place */
+} VectorArena;
+
+/* !! PRIVATE !! — Do not call directly */
+static inline size_t private_vector_arena_round(size_t n)
+{
+    return (n + (VECTOR_ARENA_ALIGN - 1)) & ~(size_t)(VECTOR_ARENA_ALIGN - 1);
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline char *private_vector_arena_payload(VectorArenaBlock *b)
+{
+    return (char *)(b + 1);
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_arena_bump(VectorArena *a, size_t size)
+{
+    size = private_vector_arena_round(size);
+    if (a->head == NULL_PTR || a->head->capacity - a->head->used < size) {
+        VectorArenaBlock *b = NULL_PTR;
+        if (a->spare != NULL_PTR && a->spare->capacity >= size) {
+            b = a->spare;
+            a->spare = b->next;
+        } else {
+            size_t cap = size > a->block_size ? size : a->block_size;
+            b = (VectorArenaBlock *)CLIB_PREFIX malloc(sizeof(VectorArenaBlock) + cap);
+            if (UNLIKELY(b == NULL_PTR)) return NULL_PTR;
+            b->capacity = cap;
+        }
+        b->used = 0;
+        b->next = a->head;
+        a->head = b;
+    }
+    void *p = private_vector_arena_payload(a->head) + a->head->used;
+    a->head->used += size;
+    a->last = p;
+    return p;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorArena *a = (VectorArena *)ctx;
+    if (ptr != NULL_PTR && ptr == a->last) {
+        /* Top of the current block: grow or shrink in place. */
+        size_t start = (size_t)((char *)ptr - private_vector_arena_payload(a->head));
+        size_t need  = private_vector_arena_round(new_size);
+        if (start + need <= a->head->capacity) {
+            a->head->used = start + need;
+            return ptr;
+        }
+    } else if (ptr != NULL_PTR && new_size <= old_size) {
+        return ptr;
+    }
+    void *p = private_vector_arena_bump(a, new_size);
+    if (UNLIKELY(p == NULL_PTR)) return NULL_PTR;
+    if (ptr != NULL_PTR)
+        memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_arena_free(void *ctx, void *ptr, size_t size)
+{
+    VectorArena *a = (VectorArena *)ctx;
+    (void)size;
+    /* Only the top allocation can be given back; everything else waits for reset. */
+    if (ptr != NULL_PTR && ptr == a->last) {
+        a->head->used = (size_t)((char *)ptr - private_vector_arena_payload(a->head));
+        a->last = NULL_PTR;
+    }
+}
+
+/**
+ * Initializes an arena. No memory is allocated until the first vector grows.
+ * @param arena      Pointer to the VectorArena to initialize.
+ * @param block_size Minimum size in bytes of each arena block (0 = VECTOR_ARENA_DEFAULT_BLOCK).
+ */
+static inline void vector_arena_init(VectorArena *arena, size_t block_size)
+{
+    arena->allocator.realloc_fn = private_vector_arena_realloc;
+    arena->allocator.free_fn    = private_vector_arena_free;
+    arena->allocator.ctx        = arena;
+    arena->allocator.growth     = NULL_PTR;
+    arena->head       = NULL_PTR;
+    arena->spare      = NULL_PTR;
+    arena->block_size = block_size ? private_vector_arena_round(block_size) : VECTOR_ARENA_DEFAULT_BLOCK;
+    arena->last       = NULL_PTR;
+}
+
+/**
+ * Returns the allocator to pass to `vector_init_with_allocator`.
+ */
+static inline const VectorAllocator *vector_arena_allocator(VectorArena *arena)
+{
+    return &arena->allocator;
+}
+
+/**
+ * Releases every allocation made from the arena in one step.
+ * Blocks are kept and reused by later allocations.
+ */
+static inline void vector_arena_reset(VectorArena *arena)
+{
+    while (arena->head != NULL_PTR) {
+        VectorArenaBlock *b = arena->head;
+        arena->head = b->next;
+        b->next = arena->spare;
+        arena->spare = b;
+    }
+    arena->last = NULL_PTR;
+}
+
+/**
+ * Frees all arena blocks. The arena must be re-initialized before reuse.
+ */
+static inline void vector_arena_destroy(VectorArena *arena)
+{
+    vector_arena_reset(arena);
+    while (arena->spare != NULL_PTR) {
+        VectorArenaBlock *b = arena->spare;
+        arena->spare = b->next;
+        CLIB_PREFIX free(b);
+    }
+}
+
+/**
+ * @section Size-Class Pool
+ * -------------------------------------------------------------------------
+ * Classes are powers of two from 1 << VECTOR_POOL_MIN_SHIFT to 1 << VECTOR_POOL_MAX_SHIFT
+ * bytes. Vector capacities grow geometrically, so a block freed by one vector
+ * is exactly the size the next short-lived vector asks for.
+ */
+
+#ifndef VECTOR_POOL_MIN_SHIFT
+    #define VECTOR_POOL_MIN_SHIFT 4     /* 16 bytes */
+#endif
+#ifndef VECTOR_POOL_MAX_SHIFT
+    #define VECTOR_POOL_MAX_SHIFT 16    /* 64 KiB */
+#endif
+#ifndef VECTOR_POOL_SLAB_SIZE
+    #define VECTOR_POOL_SLAB_SIZE (256u * 1024u)
+#endif
+
+#define VECTOR_POOL_CLASS_COUNT (VECTOR_POOL_MAX_SHIFT - VECTOR_POOL_MIN_SHIFT + 1)
+
+typedef struct VectorPoolNode {
+    struct VectorPoolNode *next;
+} VectorPoolNode;
+
+/* Header placed in front of slabs and of blocks larger than the biggest class. */
+typedef struct VectorPoolChunk {
+    struct VectorPoolChunk *prev;
+    struct VectorPoolChunk *next;
+} VectorPoolChunk;
+
+typedef struct {
+    VectorAllocator  allocator;
+    VectorPoolNode  *free_lists[VECTOR_POOL_CLASS_COUNT];
+    VectorPoolChunk *slabs;
+    VectorPoolChunk *large;
+    char            *slab_cursor;
+    size_t           slab_left;
+} VectorPool;
+
+/* !! PRIVATE !! — Returns the size class for n bytes, or -1 if n needs a large block */
+static inline int private_vector_pool_class(size_t n)
+{
+    if (n > ((size_t)1 << VECTOR_POOL_MAX_SHIFT)) return -1;
+    int c = 0;
+    size_t sz = (size_t)1 << VECTOR_POOL_MIN_SHIFT;
+    while (sz < n) { sz <<= 1; c++; }
+    return c;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_pool_alloc(VectorPool *p, size_t n)
+{
+    int c = private_vector_pool_class(n);
+    if (c < 0) {
+        VectorPoolChunk *ch = (VectorPoolChunk *)CLIB_PREFIX malloc(sizeof(VectorPoolChunk) + n);
+        if (UNLIKELY(ch == NULL_PTR)) return NULL_PTR;
+        ch->prev = NULL_PTR;
+        ch->next = p->large;
+        if (p->large) p->large->prev = ch;
+        p->large = ch;
+        return ch + 1;
+    }
+    if (p->free_lists[c] != NULL_PTR) {
+        VectorPoolNode *node = p->free_lists[c];
+        p->free_lists[c] = node->next;
+        return node;
+    }
+    size_t sz = (size_t)1 << (c + VECTOR_POOL_MIN_SHIFT);
+    if (p->slab_left < sz) {
+        size_t slab = VECTOR_POOL_SLAB_SIZE > sz ? VECTOR_POOL_SLAB_SIZE : sz;
+        VectorPoolChunk *ch = (VectorPoolChunk *)CLIB_PREFIX malloc(sizeof(VectorPoolChunk) + slab);
+        if (UNLIKELY(ch == NULL_PTR)) return NULL_PTR;
+        ch->prev = NULL_PTR;
+        ch->next = p->slabs;
+        p->slabs = ch;
+        p->slab_cursor = (char *)(ch + 1);
+        p->slab_left   = slab;
+    }
+    void *r = p->slab_cursor;
+    p->slab_cursor += sz;
+    p->slab_left   -= sz;
+    return r;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_pool_release(VectorPool *p, void *ptr, size_t n)
+{
+    if (ptr == NULL_PTR) return;
+    int c = private_vector_pool_class(n);
+    if (c < 0) {
+        VectorPoolChunk *ch = (VectorPoolChunk *)ptr - 1;
+        if (ch->prev) ch->prev->next = ch->next; else p->large = ch->next;
+        if (ch->next) ch->next->prev = ch->prev;
+        CLIB_PREFIX free(ch);
+        return;
+    }
+    VectorPoolNode *node = (VectorPoolNode *)ptr;
+    node->next = p->free_lists[c];
+    p->free_lists[c] = node;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_pool_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorPool *p = (VectorPool *)ctx;
+    if (ptr != NULL_PTR) {
+        int oc = private_vector_pool_class(old_size);
+        if (oc >= 0 && oc == private_vector_pool_class(new_size)) return ptr;
+    }
+    void *r = private_vector_pool_alloc(p, new_size);
+    if (UNLIKELY(r == NULL_PTR)) return NULL_PTR;
+    if (ptr != NULL_PTR) {
+        memcpy(r, ptr, old_size < new_size ? old_size : new_size);
+        private_vector_pool_release(p, ptr, old_size);
+    }
+    return r;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_pool_free(void *ctx, void *ptr, size_t size)
+{
+    private_vector_pool_release((VectorPool *)ctx, ptr, size);
+}
+
+/**
+ * Initializes an empty pool. Slabs are allocated on demand.
+ */
+static inline void vector_pool_init(VectorPool *pool)
+{
+    pool->allocator.realloc_fn = private_vector_pool_realloc;
+    pool->allocator.free_fn    = private_vector_pool_free;
+    pool->allocator.ctx        = pool;
+    pool->allocator.growth     = NULL_PTR;
+    for (int i = 0; i < VECTOR_POOL_CLASS_COUNT; i++)
+        pool->free_lists[i] = NULL_PTR;
+    pool->slabs       = NULL_PTR;
+    pool->large       = NULL_PTR;
+    pool->slab_cursor = NULL_PTR;
+    pool->slab_left   = 0;
+}
+
+/**
+ * Returns the allocator to pass to `vector_init_with_allocator`.
+ */
+static inline const VectorAllocator *vector_pool_allocator(VectorPool *pool)
+{
+    return &pool->allocator;
+}
+
+/**
+ * Releases every block handed out by the pool, including large blocks.
+ * The pool stays initialized and can be reused immediately.
+ */
+static inline void vector_pool_reset(VectorPool *pool)
+{
+    while (pool->slabs != NULL_PTR) {
+        VectorPoolChunk *ch = pool->slabs;
+        pool->slabs = ch->next;
+        CLIB_PREFIX free(ch);
+    }
+    while (pool->large != NULL_PTR) {
+        VectorPoolChunk *ch = pool->large;
+        pool->large = ch->next;
+        CLIB_PREFIX free(ch);
+    }
+    vector_pool_init(pool);
+}
+
+/**
+ * Frees all pool memory. Equivalent to `vector_pool_reset`.
+ */
+static inline void vector_pool_destroy(VectorPool *pool)
+{
+    vector_pool_reset(pool);
+}
+
+#endif /* VECTOR_ALLOC_H */
@@ -0,0 +1,327 @@
+/*!
+    @file vector_bits.h header file
+    @brief  packed bit vector (64 flags per word) and mask-driven vector_remove_if_mask.
+
+    `VectorBits` stores one bit per element on top of a regular vector(uint64_t)
+    of words, so growth, allocators and VECTOR_STATS behave as for any vector.
+    Bit i lives in word i / 64 at position i % 64. Bits past `size` in the last
+    word are always zero, so count and the word-wise operations need no tail
+    masking.
+
+    @details
+    - vector_bits_and / _or / _andnot combine two bit vectors of equal size a
+      SIMD register at a time (same ISA selection as the scan kernels; scalar
+      with VECTOR_NO_SIMD).
+    - vector_bits_foreach_set visits set bits only, one ctz per bit, skipping
+      zero words.
+    - vector_bits_select builds a mask from a predicate over a vector; the mask
+      feeds vector_remove_if_mask (or another mask through and/or/andnot).
+
+    @example
+      VectorBits hidden;
+      vector_bits_init(hidden);
+      vector_bits_select(hidden, rows, is_hidden);       // 1 bit per row
+      vector_bits_or(hidden, filtered);
+      printf("%zu hidden\n", vector_bits_count(hidden));
+      vector_bits_foreach_set(hidden, i) log_row(rows.data[i]);
+      vector_remove_if_mask(rows, hidden);
+      vector_bits_destroy(hidden);
+*/
+
+#ifndef VECTOR_BITS_H
+#define VECTOR_BITS_H
+
+#include "vector.h"
+
+typedef struct {
+    vector(uint64_t) words;     /* words.size == (size + 63) / 64 */
+    size_t           size;      /* number of bits */
+} VectorBits;
+
+/* !! PRIVATE !! — Words needed for n bits */
+#define private_vector_bits_words(n) (((size_t)(n) + 63) >> 6)
+
+/* !! PRIVATE !! — Sets (value != 0) or clears bits [from, to) */
+static inline void private_vector_bits_fill(uint64_t *w, size_t from, size_t to, int value)
+{
+    if (from >= to) return;
+    size_t   fw = from >> 6, lw = (to - 1) >> 6;
+    uint64_t fm = ~(uint64_t)0 << (from & 63);
+    uint64_t lm = ~(uint64_t)0 >> (63 - ((to - 1) & 63));
+    if (fw == lw) fm &= lm;
+    w[fw] = value ? (w[fw] | fm) : (w[fw] & ~fm);
+    if (fw == lw) return;
+    if (lw > fw + 1) memset(w + fw + 1, value ? 0xFF : 0, (lw - fw - 1) * sizeof(uint64_t));
+    w[lw] = value ? (w[lw] | lm) : (w[lw] & ~lm);
+}
+
+/* !! PRIVATE !! — Index of the first set bit >= from, or size */
+static inline size_t private_vector_bits_next(const uint64_t *w, size_t size, size_t from)
+{
+    if (from >= size) return size;
+    size_t   i  = from >> 6, nw = private_vector_bits_words(size);
+    uint64_t m  = w[i] & (~(uint64_t)0 << (from & 63));
+    while (m == 0) {
+        if (++i >= nw) return size;
+        m = w[i];
+    }
+    return (i << 6) + VECTOR_CTZ64(m);
+}
+
+/* !! PRIVATE !! — Number of set bits in the first `words` words */
+static inline size_t private_vector_bits_popcount(const uint64_t *w, size_t words)
+{
+    size_t c = 0;
+    for (size_t i = 0; i < words; i++) c += VECTOR_POPCOUNT64(w[i]);
+    return c;
+}
+
+/* !! PRIVATE !! — Register-wide bitwise ops; andnot(a, b) is a & ~b */
+#if defined(VECTOR_SIMD_AVX512)
+    #define private_vector_bits_load(p)         _mm512_loadu_si512((const void *)(p))
+    #define private_vector_bits_store(p, r)     _mm512_storeu_si512((void *)(p), r)
+    #define private_vector_bits_simd_and(a, b)      _mm512_and_si512(a, b)
+    #define private_vector_bits_simd_or(a, b)       _mm512_or_si512(a, b)
+    #define private_vector_bits_simd_andnot(a, b)   _mm512_andnot_si512(b, a)
+#elif defined(VECTOR_SIMD_AVX2)
+    #define private_vector_bits_load(p)         _mm256_loadu_si256((const __m256i *)(const void *)(p))
+    #define private_vector_bits_store(p, r)     _mm256_storeu_si256((__m256i *)(void *)(p), r)
+    #define private_vector_bits_simd_and(a, b)      _mm256_and_si256(a, b)
+    #define private_vector_bits_simd_or(a, b)       _mm256_or_si256(a, b)
+    #define private_vector_bits_simd_andnot(a, b)   _mm256_andnot_si256(b, a)
+#elif defined(VECTOR_SIMD_SSE2)
+    #define private_vector_bits_load(p)         _mm_loadu_si128((const __m128i *)(const void *)(p))
+    #define private_vector_bits_store(p, r)     _mm_storeu_si128((__m128i *)(void *)(p), r)
+    #define private_vector_bits_simd_and(a, b)      _mm_and_si128(a, b)
+    #define private_vector_bits_simd_or(a, b)       _mm_or_si128(a, b)
+    #define private_vector_bits_simd_andnot(a, b)   _mm_andnot_si128(b, a)
+#elif defined(VECTOR_SIMD_NEON)
+    #define private_vector_bits_load(p)         vld1q_u64((const uint64_t *)(p))
+    #define private_vector_bits_store(p, r)     vst1q_u64((uint64_t *)(p), r)
+    #define private_vector_bits_simd_and(a, b)      vandq_u64(a, b)
+    #define private_vector_bits_simd_or(a, b)       vorrq_u64(a, b)
+    #define private_vector_bits_simd_andnot(a, b)   vbicq_u64(a, b)
+#endif
+
+/* !! PRIVATE !! — Generates dst[i] = dst[i] OP src[i] over `words` words */
+#ifdef VECTOR_SIMD_BYTES
+#define PRIVATE_VECTOR_BITS_KERNEL(name, scalar) \
+static inline void private_vector_bits_##name(uint64_t *dst, const uint64_t *src, size_t words) \
+{ \
+    const size_t lanes = VECTOR_SIMD_BYTES / sizeof(uint64_t); \
+    size_t i = 0; \
+    for (; i + lanes <= words; i += lanes) \
+        private_vector_bits_store(dst + i, private_vector_bits_simd_##name( \
+            private_vector_bits_load(dst + i), private_vector_bits_load(src + i))); \
+    for (; i < words; i++) dst[i] = (scalar); \
+}
+#else
+#define PRIVATE_VECTOR_BITS_KERNEL(name, scalar) \
+static inline void private_vector_bits_##name(uint64_t *dst, const uint64_t *src, size_t words) \
+{ \
+    for (size_t i = 0; i < words; i++) dst[i] = (scalar); \
+}
+#endif
+
+PRIVATE_VECTOR_BITS_KERNEL(and,    dst[i] &  src[i])
+PRIVATE_VECTOR_BITS_KERNEL(or,     dst[i] |  src[i])
+PRIVATE_VECTOR_BITS_KERNEL(andnot, dst[i] & ~src[i])
+
+/**
+ * Initializes an empty bit vector. No memory is allocated until the first push/resize.
+ */
+#define vector_bits_init(b) do { \
+    vector_init((b).words); \
+    (b).size = 0; \
+} while(0)
+
+/**
+ * Initializes an empty bit vector whose words use a custom VectorAllocator.
+ */
+#define vector_bits_init_with_allocator(b, alloc) do { \
+    vector_init_with_allocator((b).words, alloc); \
+    (b).size = 0; \
+} while(0)
+
+#define vector_bits_size(b)     ((b).size)
+#define vector_bits_empty(b)    ((b).size == 0)
+#define vector_bits_data(b)     ((b).words.data)            /* uint64_t*, (size + 63) / 64 words */
+
+/**
+ * Reserves room for at least nbits bits.
+ */
+#define vector_bits_reserve(b, nbits) vector_reserve((b).words, private_vector_bits_words(nbits))
+
+/**
+ * Resizes to nbits bits; new bits are set to (value != 0), existing bits are kept.
+ */
+#define vector_bits_resize(b, nbits, value) do { \
+    if (UNLIKELY(!vector_is_valid((b).words))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_bits_resize'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _nb = (size_t)(nbits); \
+    size_t _nw = private_vector_bits_words(_nb); \
+    vector_resize((b).words, _nw, (uint64_t)0); \
+    if (UNLIKELY((b).words.size != _nw)) break; \
+    if (_nb > (b).size) private_vector_bits_fill((b).words.data, (b).size, _nb, (value) != 0); \
+    else                private_vector_bits_fill((b).words.data, _nb, _nw << 6, 0); \
+    (b).size = _nb; \
+} while(0)
+
+/**
+ * Appends one bit (value != 0).
+ */
+#define vector_bits_push_back(b, value) do { \
+    if (UNLIKELY(!vector_is_valid((b).words))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_bits_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (((b).size & 63) == 0) { \
+        size_t _ws = (b).words.size; \
+        vector_push_back((b).words, (uint64_t)0); \
+        if (UNLIKELY((b).words.size == _ws)) break; \
+    } \
+    (b).words.data[(b).size >> 6] |= (uint64_t)((value) != 0) << ((b).size & 63); \
+    (b).size++; \
+} while(0)
+
+#ifdef VECTOR_UNCHECKED
+    #define vector_bits_at(b, index) \
+        ((int)(((b).words.data[(size_t)(index) >> 6] >> ((size_t)(index) & 63)) & 1))
+#else
+/**
+ * @brief Bounds-checked read of bit `index` (int, 0 or 1). Aborts on out-of-bounds.
+ */
+#define vector_bits_at(b, index) \
+    ((vector_is_valid((b).words) && (size_t)(index) < (b).size) ? \
+     (int)(((b).words.data[(size_t)(index) >> 6] >> ((size_t)(index) & 63)) & 1) : \
+     (private_vector_fail("[x] Error: out-of-bounds access", __FILE__, __LINE__), \
+      abort(), VECTOR_UNREACHABLE(), 0))
+#endif
+
+/**
+ * Sets bit `index` to (value != 0).
+ */
+#define vector_bits_set(b, index, value) do { \
+    size_t _bi = (size_t)(index); \
+    if (VECTOR_CHECK(!vector_is_valid((b).words) || _bi >= (b).size)) { \
+        private_vector_fail("[x] Error: index out of bounds in 'vector_bits_set'", __FILE__, __LINE__); \
+        break; \
+    } \
+    uint64_t _bm = (uint64_t)1 << (_bi & 63); \
+    if (value) (b).words.data[_bi >> 6] |=  _bm; \
+    else       (b).words.data[_bi >> 6] &= ~_bm; \
+} while(0)
+
+/**
+ * Sets every bit to (value != 0); the size is unchanged.
+ */
+#define vector_bits_fill(b, value) do { \
+    if (UNLIKELY(!vector_is_valid((b).words))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_bits_fill'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_bits_fill((b).words.data, 0, (b).size, (value) != 0); \
+} while(0)
+
+/**
+ * Removes all bits without freeing memory.
+ */
+#define vector_bits_clear(b) do { \
+    vector_clear((b).words); \
+    (b).size = 0; \
+} while(0)
+
+/**
+ * Number of set bits (size_t), one popcount per word.
+ */
+#define vector_bits_count(b) \
+    private_vector_bits_popcount((b).words.data, private_vector_bits_words((b).size))
+
+/**
+ * Index of the first set bit at or after `from` (size_t); vector_bits_size(b) if there is none.
+ */
+#define vector_bits_next_set(b, from) \
+    private_vector_bits_next((b).words.data, (b).size, (size_t)(from))
+
+/**
+ * Loops over the indices of the set bits in ascending order; `index` is a size_t.
+ * `break` and `continue` work as in a plain for loop.
+ */
+#define vector_bits_foreach_set(b, index) \
+    for (size_t index = vector_bits_next_set(b, 0); \
+         index < (b).size; \
+         index = vector_bits_next_set(b, index + 1))
+
+/* !! PRIVATE !! — dst = dst OP src for two bit vectors of equal size */
+#define private_vector_bits_binary(dst, src, name) do { \
+    if (UNLIKELY(!vector_is_valid((dst).words) || !vector_is_valid((src).words))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_bits_" #name "'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY((dst).size != (src).size)) { \
+        private_vector_fail("[x] Error: size mismatch in 'vector_bits_" #name "'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_bits_##name((dst).words.data, (src).words.data, private_vector_bits_words((dst).size)); \
+} while(0)
+
+/**
+ * dst &= src, dst |= src, dst &= ~src. Both bit vectors must have the same size.
+ */
+#define vector_bits_and(dst, src)       private_vector_bits_binary(dst, src, and)
+#define vector_bits_or(dst, src)        private_vector_bits_binary(dst, src, or)
+#define vector_bits_andnot(dst, src)    private_vector_bits_binary(dst, src, andnot)
+
+/**
+ * Replaces the contents of b with one bit per element of vec: bit i = (pred(vec.data[i]) != 0).
+ * The predicate is expanded inline and evaluated 64 elements per output word.
+ * @param pred Predicate function or macro: pred(item) -> nonzero to select.
+ */
+#define vector_bits_select(b, vec, pred) do { \
+    if (UNLIKELY(!vector_is_valid((b).words) || !vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_bits_select'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n  = (vec).size; \
+    size_t _nw = private_vector_bits_words(_n); \
+    vector_resize((b).words, _nw, (uint64_t)0); \
+    if (UNLIKELY((b).words.size != _nw)) break; \
+    for (size_t _wi = 0; _wi < _nw; _wi++) { \
+        size_t   _base = _wi << 6; \
+        size_t   _end  = _n - _base < 64 ? _n - _base : 64; \
+        uint64_t _m    = 0; \
+        for (size_t _k = 0; _k < _end; _k++) \
+            _m |= (uint64_t)(pred((vec).data[_base + _k]) != 0) << _k; \
+        (b).words.data[_wi] = _m; \
+    } \
+    (b).size = _n; \
+} while(0)
+
+/**
+ * Frees the words and marks the bit vector destroyed.
+ */
+#define vector_bits_destroy(b) do { \
+    vector_destroy((b).words); \
+    (b).size = 0; \
+} while(0)
+
+/**
+ * Removes every element of vec whose bit is set in mask, compacting in a single O(N) pass
+ * like vector_remove_if. mask must have exactly vec.size bits.
+ */
+#define vector_remove_if_mask(vec, mask) do { \
+    if (UNLIKELY(!vector_is_valid(vec) || !vector_is_valid((mask).words))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_remove_if_mask'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY((mask).size != (vec).size)) { \
+        private_vector_fail("[x] Error: mask size mismatch in 'vector_remove_if_mask'", __FILE__, __LINE__); \
+        break; \
+    } \
+    const uint64_t *_mw = (mask).words.data; \
+    private_vector_remove_where(vec, (_mw[_i >> 6] >> (_i & 63)) & 1); \
+} while(0)
+
+#endif /* VECTOR_BITS_H */
@@ -0,0 +1,621 @@
+/*!
+    @file vector_chunked.h header file
+    @brief  chunked vectors: O(log n) insert and erase at any position.
+
+    `vector_chunked(type)` stores its elements in fixed-size leaves of
+    VECTOR_CHUNKED_LEAF_BYTES under a counted B+-tree: every inner node keeps
+    the element count of each child, so reaching index i is one descent of a
+    few levels and an insert or erase only moves the elements of one leaf,
+    instead of the whole tail that vector_insert / vector_erase memmove.
+
+    @details
+    - Insert splits full nodes on the way down, so a failed allocation leaves
+      the tree valid and the element not inserted. Appending at the end fills
+      leaves completely instead of splitting them in half.
+    - Erase frees leaves that become empty and merges a leaf that drops below
+      a quarter full into a neighbour when both fit in half a leaf.
+    - The leaves are linked in index order: vector_chunked_foreach walks them
+      sequentially, and vector_chunked_flatten copies them into a regular
+      `vector(type)` with one reservation and one memcpy per leaf.
+    - With 4 KiB leaves and a fanout of 64, 100M ints are three levels deep.
+
+    @example
+      vector_chunked(LogLine) log;
+      vector_chunked_init(log);
+      vector_chunked_push_back(log, line);
+      vector_chunked_insert(log, 50000000, edited);       // moves at most one leaf
+      vector_chunked_foreach(log, it) emit(it);
+      vector(LogLine) flat;
+      vector_init(flat);
+      vector_chunked_flatten(log, flat);
+      vector_chunked_destroy(log);
+
+    @warning
+    - Elements must be trivially copyable (they are moved with memcpy).
+    - Element pointers are invalidated by any insert or erase.
+    - Random access costs a descent; iterate with vector_chunked_foreach.
+*/
+
+#ifndef VECTOR_CHUNKED_H
+#define VECTOR_CHUNKED_H
+
+#include "vector.h"
+
+/* Bytes per leaf (header included); a leaf holds at least 8 elements. */
+#ifndef VECTOR_CHUNKED_LEAF_BYTES
+    #define VECTOR_CHUNKED_LEAF_BYTES 4096
+#endif
+
+/* Children per inner node. */
+#ifndef VECTOR_CHUNKED_FANOUT
+    #define VECTOR_CHUNKED_FANOUT 64
+#endif
+
+/* Deepest tree supported; 32^(height - 1) inserts are needed to reach a height. */
+#define VECTOR_CHUNKED_MAX_HEIGHT 24
+
+typedef struct VectorChunkLeaf {
+    struct VectorChunkLeaf *next;
+    struct VectorChunkLeaf *prev;
+    size_t                  size;
+} VectorChunkLeaf;
+
+typedef struct {
+    size_t children;
+    size_t counts[VECTOR_CHUNKED_FANOUT];   /* elements under each child */
+    void  *child[VECTOR_CHUNKED_FANOUT];
+} VectorChunkInner;
+
+/* Elements of a leaf start this far into it. */
+#define VECTOR_CHUNKED_LEAF_HEADER ((sizeof(VectorChunkLeaf) + 15) & ~(size_t)15)
+
+#define VECTOR_CHUNKED_FIELDS(type) \
+        void                  *root;           /* leaf when height == 0, NULL when empty */ \
+        VectorChunkLeaf       *first; \
+        VectorChunkLeaf       *last; \
+        type                  *elem;           /* never set: carries the element type */ \
+        size_t                 size; \
+        size_t                 height; \
+        size_t                 leaf_capacity;  /* elements per leaf */ \
+        const VectorAllocator *allocator; \
+        VECTOR_MAGIC_FIELD
+
+typedef struct {
+    VECTOR_CHUNKED_FIELDS(void)
+} VectorChunkedBase;
+
+/**
+ * @brief Declares an anonymous chunked vector struct for the given type.
+ * @note  The field layout matches VectorChunkedBase.
+ */
+#define vector_chunked(type) \
+    struct { \
+        VECTOR_CHUNKED_FIELDS(type) \
+    }
+
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_CHUNKED_ASSERT_TRIVIAL(cv) \
+        static_assert( \
+            std::is_trivially_copyable<std::remove_pointer<TYPE_OF_VAL((cv).elem)>::type>::value, \
+            "vector_chunked<T>: T must be trivially copyable" \
+        )
+#else
+    #define PRIVATE_VECTOR_CHUNKED_ASSERT_TRIVIAL(cv) /* no-op in C */
+#endif
+
+/* !! PRIVATE !! — `out` must hold the element type of `cv` (in C only the sizes are compared, like VECTOR_ASSERT_SAME_TYPE) */
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_CHUNKED_ASSERT_SAME_TYPE(cv, out) \
+        static_assert( \
+            std::is_same< \
+                typename std::remove_pointer<TYPE_OF((out).data)>::type, \
+                typename std::remove_pointer<TYPE_OF_VAL((cv).elem)>::type \
+            >::value, \
+            "vector_chunked_flatten: out must store the same type" \
+        )
+#else
+    #define PRIVATE_VECTOR_CHUNKED_ASSERT_SAME_TYPE(cv, out) \
+        _Static_assert( \
+            sizeof(*(out).data) == sizeof(*(cv).elem), \
+            "vector_chunked_flatten: element size mismatch" \
+        )
+#endif
+
+/* !! PRIVATE !! — Do not call directly */
+static inline unsigned char *private_vector_chunked_data(const VectorChunkLeaf *leaf)
+{
+    return (unsigned char *)(uintptr_t)leaf + VECTOR_CHUNKED_LEAF_HEADER;
+}
+
+/* !! PRIVATE !! — Leaf whose elements start at `data` */
+static inline VectorChunkLeaf *private_vector_chunked_leaf_of(const void *data)
+{
+    return (VectorChunkLeaf *)(void *)((unsigned char *)(uintptr_t)data - VECTOR_CHUNKED_LEAF_HEADER);
+}
+
+/* !! PRIVATE !! — vector_chunked_foreach: elements of the first leaf, NULL when empty (leaves never are) */
+static inline void *private_vector_chunked_begin(const VectorChunkLeaf *first)
+{
+    return first != NULL_PTR ? private_vector_chunked_data(first) : NULL_PTR;
+}
+
+/* !! PRIVATE !! — vector_chunked_foreach: elements of the leaf after the one starting at `data`, NULL after the last */
+static inline void *private_vector_chunked_next(const void *data)
+{
+    return private_vector_chunked_begin(private_vector_chunked_leaf_of(data)->next);
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline size_t private_vector_chunked_leaf_bytes(const VectorChunkedBase *cv, size_t elem_size)
+{
+    return VECTOR_CHUNKED_LEAF_HEADER + cv->leaf_capacity * elem_size;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_chunked_setup(VectorChunkedBase *cv, size_t elem_size, const VectorAllocator *alloc)
+{
+    size_t cap = (VECTOR_CHUNKED_LEAF_BYTES - VECTOR_CHUNKED_LEAF_HEADER) / elem_size;
+    cv->root          = NULL_PTR;
+    cv->first         = NULL_PTR;
+    cv->last          = NULL_PTR;
+    cv->elem          = NULL_PTR;
+    cv->size          = 0;
+    cv->height        = 0;
+    cv->leaf_capacity = cap < 8 ? 8 : cap;
+    cv->allocator     = alloc;
+}
+
+/* !! PRIVATE !! — Whether the node at `height` (0 = leaf) has no room left */
+static inline int private_vector_chunked_full(const VectorChunkedBase *cv, const void *node, size_t height)
+{
+    return height == 0 ? ((const VectorChunkLeaf *)node)->size >= cv->leaf_capacity
+                       : ((const VectorChunkInner *)node)->children >= VECTOR_CHUNKED_FANOUT;
+}
+
+/* !! PRIVATE !! — Opens slot `c` of an inner node (c <= children < FANOUT) */
+static inline void private_vector_chunked_open_slot(VectorChunkInner *in, size_t c, void *child, size_t count)
+{
+    memmove(&in->child[c + 1], &in->child[c], (in->children - c) * sizeof(in->child[0]));
+    memmove(&in->counts[c + 1], &in->counts[c], (in->children - c) * sizeof(in->counts[0]));
+    in->child[c]  = child;
+    in->counts[c] = count;
+    in->children++;
+}
+
+/* !! PRIVATE !! — Closes slot `c` of an inner node */
+static inline void private_vector_chunked_close_slot(VectorChunkInner *in, size_t c)
+{
+    in->children--;
+    memmove(&in->child[c], &in->child[c + 1], (in->children - c) * sizeof(in->child[0]));
+    memmove(&in->counts[c], &in->counts[c + 1], (in->children - c) * sizeof(in->counts[0]));
+}
+
+/* !! PRIVATE !! — Unlinks a leaf from the leaf list and frees it */
+static inline void private_vector_chunked_drop_leaf(VectorChunkedBase *cv, VectorChunkLeaf *leaf, size_t elem_size)
+{
+    if (leaf->prev != NULL_PTR) leaf->prev->next = leaf->next; else cv->first = leaf->next;
+    if (leaf->next != NULL_PTR) leaf->next->prev = leaf->prev; else cv->last = leaf->prev;
+    private_vector_free(cv->allocator, leaf, private_vector_chunked_leaf_bytes(cv, elem_size));
+}
+
+/*
+ * !! PRIVATE !! — Splits the full child `c` of `parent` (at `height`) in two.
+ * A leaf that is appended to at its end (`local` == its size) and is the last one
+ * keeps every element, so sequential appends leave full leaves behind.
+ * Returns 0, or -1 if the new node could not be allocated (nothing changed).
+ */
+static inline int private_vector_chunked_split
+(
+    VectorChunkedBase *cv, VectorChunkInner *parent, size_t c, size_t height,
+    size_t local, size_t elem_size
+)
+{
+    size_t moved;
+    if (height == 0) {
+        VectorChunkLeaf *left = (VectorChunkLeaf *)parent->child[c];
+        VectorChunkLeaf *right = (VectorChunkLeaf *)private_vector_realloc(cv->allocator, NULL_PTR, 0,
+                                                     private_vector_chunked_leaf_bytes(cv, elem_size));
+        if (UNLIKELY(right == NULL_PTR)) return -1;
+        moved = (left == cv->last && local == left->size) ? 0 : left->size / 2;
+        memcpy(private_vector_chunked_data(right), private_vector_chunked_data(left) + (left->size - moved) * elem_size,
+               moved * elem_size);
+        right->size = moved;
+        left->size -= moved;
+        right->prev = left;
+        right->next = left->next;
+        if (left->next != NULL_PTR) left->next->prev = right; else cv->last = right;
+        left->next = right;
+        private_vector_chunked_open_slot(parent, c + 1, right, moved);
+    } else {
+        VectorChunkInner *left = (VectorChunkInner *)parent->child[c];
+        VectorChunkInner *right = (VectorChunkInner *)private_vector_realloc(cv->allocator, NULL_PTR, 0,
+                                                                             sizeof(VectorChunkInner));
+        if (UNLIKELY(right == NULL_PTR)) return -1;
+        size_t keep = left->children / 2, k;
+        right->children = left->children - keep;
+        moved = 0;
+        for (k = 0; k < right->children; k++) {
+            right->child[k]  = left->child[keep + k];
+            right->counts[k] = left->counts[keep + k];
+            moved += right->counts[k];
+        }
+        left->children = keep;
+        private_vector_chunked_open_slot(parent, c + 1, right, moved);
+    }
+    parent->counts[c] -= moved;
+    return 0;
+}
+
+/* !! PRIVATE !! — Child of `in` (children at `height`) for inserting at `*local`; the boundary prefers a child with room */
+static inline size_t private_vector_chunked_pick_insert
+(
+    const VectorChunkedBase *cv, const VectorChunkInner *in, size_t height, size_t *local
+)
+{
+    size_t c = 0;
+    while (c + 1 < in->children &&
+           (*local > in->counts[c] ||
+            (*local == in->counts[c] && private_vector_chunked_full(cv, in->child[c], height)))) {
+        *local -= in->counts[c];
+        c++;
+    }
+    return c;
+}
+
+/* !! PRIVATE !! — Inserts one element at `index` (<= size); returns 0, or -1 on allocation failure (nothing inserted) */
+static inline int private_vector_chunked_insert(void *cv_ptr, size_t index, const void *elem, size_t elem_size)
+{
+    VectorChunkedBase *cv = (VectorChunkedBase *)cv_ptr;
+    VectorChunkInner  *path[VECTOR_CHUNKED_MAX_HEIGHT];
+    size_t             slot[VECTOR_CHUNKED_MAX_HEIGHT];
+    size_t             depth = 0, h, i = index, c;
+
+    if (cv->root == NULL_PTR) {
+        VectorChunkLeaf *leaf = (VectorChunkLeaf *)private_vector_realloc(cv->allocator, NULL_PTR, 0,
+                                                    private_vector_chunked_leaf_bytes(cv, elem_size));
+        if (UNLIKELY(leaf == NULL_PTR)) return -1;
+        leaf->next = leaf->prev = NULL_PTR;
+        leaf->size = 0;
+        cv->root = cv->first = cv->last = leaf;
+        cv->height = 0;
+    }
+    if (private_vector_chunked_full(cv, cv->root, cv->height)) {
+        /* Grow by one level: a new root holding the old one, then split it. */
+        if (UNLIKELY(cv->height + 1 >= VECTOR_CHUNKED_MAX_HEIGHT)) return -1;
+        VectorChunkInner *root = (VectorChunkInner *)private_vector_realloc(cv->allocator, NULL_PTR, 0,
+                                                                            sizeof(VectorChunkInner));
+        if (UNLIKELY(root == NULL_PTR)) return -1;
+        root->children  = 1;
+        root->child[0]  = cv->root;
+        root->counts[0] = cv->size;
+        if (private_vector_chunked_split(cv, root, 0, cv->height, index, elem_size) != 0) {
+            private_vector_free(cv->allocator, root, sizeof(VectorChunkInner));
+            return -1;
+        }
+        cv->root = root;
+        cv->height++;
+    }
+
+    void *node = cv->root;
+    for (h = cv->height; h > 0; h--) {
+        VectorChunkInner *in = (VectorChunkInner *)node;
+        c = private_vector_chunked_pick_insert(cv, in, h - 1, &i);
+        if (private_vector_chunked_full(cv, in->child[c], h - 1)) {
+            if (private_vector_chunked_split(cv, in, c, h - 1, i, elem_size) != 0) return -1;
+            if (i > in->counts[c] || (i == in->counts[c] && private_vector_chunked_full(cv, in->child[c], h - 1))) {
+                i -= in->counts[c];
+                c++;
+            }
+        }
+        path[depth] = in;
+        slot[depth] = c;
+        depth++;
+        node = in->child[c];
+    }
+
+    VectorChunkLeaf *leaf = (VectorChunkLeaf *)node;
+    unsigned char   *at   = private_vector_chunked_data(leaf) + i * elem_size;
+    memmove(at + elem_size, at, (leaf->size - i) * elem_size);
+    memcpy(at, elem, elem_size);
+    leaf->size++;
+    while (depth != 0) { depth--; path[depth]->counts[slot[depth]]++; }
+    cv->size++;
+    return 0;
+}
+
+/* !! PRIVATE !! — Removes the element at `index` (< size) */
+static inline void private_vector_chunked_erase(void *cv_ptr, size_t index, size_t elem_size)
+{
+    VectorChunkedBase *cv = (VectorChunkedBase *)cv_ptr;
+    VectorChunkInner  *path[VECTOR_CHUNKED_MAX_HEIGHT];
+    size_t             slot[VECTOR_CHUNKED_MAX_HEIGHT];
+    size_t             depth = 0, h, i = index, c;
+    void              *node = cv->root;
+
+    for (h = cv->height; h > 0; h--) {
+        VectorChunkInner *in = (VectorChunkInner *)node;
+        for (c = 0; i >= in->counts[c]; c++) i -= in->counts[c];
+        in->counts[c]--;
+        path[depth] = in;
+        slot[depth] = c;
+        depth++;
+        node = in->child[c];
+    }
+    VectorChunkLeaf *leaf = (VectorChunkLeaf *)node;
+    unsigned char   *at   = private_vector_chunked_data(leaf) + i * elem_size;
+    leaf->size--;
+    memmove(at, at + elem_size, (leaf->size - i) * elem_size);
+    cv->size--;
+
+    if (leaf->size == 0) {
+        /* Free the leaf, then every ancestor it leaves empty. */
+        private_vector_chunked_drop_leaf(cv, leaf, elem_size);
+        while (depth != 0) {
+            depth--;
+            private_vector_chunked_close_slot(path[depth], slot[depth]);
+            if (path[depth]->children != 0) break;
+            private_vector_free(cv->allocator, path[depth], sizeof(VectorChunkInner));
+            if (depth == 0) { cv->root = NULL_PTR; cv->height = 0; return; }
+        }
+        if (cv->height == 0) { cv->root = NULL_PTR; return; }
+    } else if (depth != 0 && leaf->size < cv->leaf_capacity / 4) {
+        /* Merge with a neighbour under the same parent when both fit in half a leaf. */
+        VectorChunkInner *in = path[depth - 1];
+        c = slot[depth - 1];
+        size_t left = (size_t)-1;
+        if (c > 0 && in->counts[c - 1] + leaf->size <= cv->leaf_capacity / 2) left = c - 1;
+        else if (c + 1 < in->children && in->counts[c + 1] + leaf->size <= cv->leaf_capacity / 2) left = c;
+        if (left != (size_t)-1) {
+            VectorChunkLeaf *l = (VectorChunkLeaf *)in->child[left];
+            VectorChunkLeaf *r = (VectorChunkLeaf *)in->child[left + 1];
+            memcpy(private_vector_chunked_data(l) + l->size * elem_size, private_vector_chunked_data(r),
+                   r->size * elem_size);
+            l->size += r->size;
+            in->counts[left] += in->counts[left + 1];
+            private_vector_chunked_close_slot(in, left + 1);
+            private_vector_chunked_drop_leaf(cv, r, elem_size);
+        }
+    }
+
+    /* Drop roots with a single child. */
+    while (cv->height > 0 && ((VectorChunkInner *)cv->root)->children == 1) {
+        VectorChunkInner *old = (VectorChunkInner *)cv->root;
+        cv->root = old->child[0];
+        cv->height--;
+        private_vector_free(cv->allocator, old, sizeof(VectorChunkInner));
+    }
+}
+
+/* !! PRIVATE !! — Address of element `index` (< size) */
+static inline void *private_vector_chunked_at(const void *cv_ptr, size_t index, size_t elem_size)
+{
+    const VectorChunkedBase *cv = (const VectorChunkedBase *)cv_ptr;
+    const void *node = cv->root;
+    size_t      h, c;
+    for (h = cv->height; h > 0; h--) {
+        const VectorChunkInner *in = (const VectorChunkInner *)node;
+        for (c = 0; index >= in->counts[c]; c++) index -= in->counts[c];
+        node = in->child[c];
+    }
+    return private_vector_chunked_data((const VectorChunkLeaf *)node) + index * elem_size;
+}
+
+/* !! PRIVATE !! — Frees the subtree under `node` (leaves included) */
+static inline void private_vector_chunked_free_node(VectorChunkedBase *cv, void *node, size_t height, size_t elem_size)
+{
+    if (height == 0) {
+        private_vector_free(cv->allocator, node, private_vector_chunked_leaf_bytes(cv, elem_size));
+        return;
+    }
+    VectorChunkInner *in = (VectorChunkInner *)node;
+    for (size_t c = 0; c < in->children; c++)
+        private_vector_chunked_free_node(cv, in->child[c], height - 1, elem_size);
+    private_vector_free(cv->allocator, in, sizeof(VectorChunkInner));
+}
+
+/* !! PRIVATE !! — Frees every node; the vector is left empty */
+static inline void private_vector_chunked_clear(void *cv_ptr, size_t elem_size)
+{
+    VectorChunkedBase *cv = (VectorChunkedBase *)cv_ptr;
+    if (cv->root != NULL_PTR) private_vector_chunked_free_node(cv, cv->root, cv->height, elem_size);
+    cv->root   = NULL_PTR;
+    cv->first  = NULL_PTR;
+    cv->last   = NULL_PTR;
+    cv->size   = 0;
+    cv->height = 0;
+}
+
+/**
+ * Initializes the chunked vector. Leaves come from the default allocator.
+ * @param cv The chunked vector structure to initialize.
+ */
+#define vector_chunked_init(cv) vector_chunked_init_with_allocator(cv, NULL_PTR)
+
+/**
+ * Initializes the chunked vector; leaves and inner nodes come from `alloc`.
+ * @param cv    The chunked vector structure to initialize.
+ * @param alloc Pointer to a VectorAllocator that outlives the vector (NULL = default).
+ */
+#define vector_chunked_init_with_allocator(cv, alloc) do { \
+    PRIVATE_VECTOR_CHUNKED_ASSERT_TRIVIAL(cv); \
+    if (private_vector_has_magic(cv, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_chunked_setup((VectorChunkedBase *)(void *)&(cv), sizeof(*(cv).elem), (alloc)); \
+    private_vector_set_magic(cv, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Returns the number of elements (macro, size_t).
+ */
+#define vector_chunked_size(cv) ((cv).size)
+
+/**
+ * Returns whether the chunked vector is empty (macro, int).
+ */
+#define vector_chunked_empty(cv) ((cv).size == 0)
+
+/**
+ * Returns a pointer to element `index` (macro, type*), or NULL_PTR if out of bounds.
+ * O(log n); valid until the next insert or erase.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_chunked_at(cv, index) ({ \
+    TYPE_OF_VAL((cv).elem) _elem = NULL_PTR; \
+    size_t _idx = (size_t)(index); \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_at'", __FILE__, __LINE__); \
+    } else if (VECTOR_CHECK(_idx >= (cv).size)) { \
+        private_vector_fail("[x] Error: index out of bounds in 'vector_chunked_at'", __FILE__, __LINE__); \
+    } else { \
+        _elem = (TYPE_OF_VAL((cv).elem))private_vector_chunked_at(&(cv), _idx, sizeof(*(cv).elem)); \
+    } \
+    _elem; \
+})
+
+/**
+ * Inserts value at position (0 to size). O(log n) plus a memmove inside one leaf.
+ * @param cv       The chunked vector.
+ * @param position Insert index.
+ * @param value    Element to insert.
+ */
+#define vector_chunked_insert(cv, position, value) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_insert'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _pos = (size_t)(position); \
+    if (VECTOR_CHECK(_pos > (cv).size)) { \
+        private_vector_fail("[x] Error: insert position out of bounds in 'vector_chunked_insert'", __FILE__, __LINE__); \
+        break; \
+    } \
+    TYPE_OF_VAL(*(cv).elem) _val = (value); \
+    if (UNLIKELY(private_vector_chunked_insert(&(cv), _pos, &_val, sizeof(_val)) != 0)) \
+        private_vector_fail("[x] Error: allocation failed in 'vector_chunked_insert'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Appends value at the end.
+ */
+#define vector_chunked_push_back(cv, value) vector_chunked_insert(cv, (cv).size, value)
+
+/**
+ * Inserts `count` elements of `arr` at position, in order.
+ * @note O(count * log n); on allocation failure, the elements before the failing one stay inserted.
+ */
+#define vector_chunked_insert_range(cv, position, arr, count) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_insert_range'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _pos = (size_t)(position); \
+    size_t _cnt = (size_t)(count); \
+    if (VECTOR_CHECK(_pos > (cv).size)) { \
+        private_vector_fail("[x] Error: insert position out of bounds in 'vector_chunked_insert_range'", __FILE__, __LINE__); \
+        break; \
+    } \
+    const TYPE_OF_VAL(*(cv).elem) *_src = (arr); \
+    for (size_t _k = 0; _k < _cnt; _k++) { \
+        if (UNLIKELY(private_vector_chunked_insert(&(cv), _pos + _k, &_src[_k], sizeof(*(cv).elem)) != 0)) { \
+            private_vector_fail("[x] Error: allocation failed in 'vector_chunked_insert_range'", __FILE__, __LINE__); \
+            break; \
+        } \
+    } \
+} while(0)
+
+/**
+ * Removes the element at position. O(log n) plus a memmove inside one leaf.
+ */
+#define vector_chunked_erase(cv, position) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_erase'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _pos = (size_t)(position); \
+    if (VECTOR_CHECK(_pos >= (cv).size)) { \
+        private_vector_fail("[x] Error: position out of bounds in 'vector_chunked_erase'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_chunked_erase(&(cv), _pos, sizeof(*(cv).elem)); \
+} while(0)
+
+/**
+ * Removes the last element.
+ */
+#define vector_chunked_pop_back(cv) do { \
+    if (VECTOR_CHECK((cv).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_chunked_pop_back' on empty vector", __FILE__, __LINE__); \
+        break; \
+    } \
+    vector_chunked_erase(cv, (cv).size - 1); \
+} while(0)
+
+/**
+ * Iterates over every element in index order using a pointer.
+ * A single loop: `break` and `continue` behave as in vector_foreach.
+ * @warning Do NOT insert or erase inside this loop.
+ * @param cv   The chunked vector to iterate over.
+ * @param item Iterator pointer variable name.
+ */
+#define vector_chunked_foreach(cv, item) \
+    for (TYPE_OF_VAL((cv).elem) item = (TYPE_OF_VAL((cv).elem))private_vector_chunked_begin((cv).first), \
+         item##_base = item, \
+         item##_end = item != NULL_PTR ? item + private_vector_chunked_leaf_of(item)->size : NULL_PTR; \
+         item != NULL_PTR; \
+         ++item == item##_end \
+            ? (void)(item = item##_base = (TYPE_OF_VAL((cv).elem))private_vector_chunked_next(item##_base), \
+                     item##_end = item != NULL_PTR ? item + private_vector_chunked_leaf_of(item)->size : NULL_PTR) \
+            : (void)0)
+
+/**
+ * Appends every element to a regular vector, in index order.
+ * @param cv  The chunked vector.
+ * @param out An initialized `vector(type)` with the same element type.
+ * @note One reservation on `out`, then one memcpy per leaf.
+ */
+#define vector_chunked_flatten(cv, out) do { \
+    PRIVATE_VECTOR_CHUNKED_ASSERT_SAME_TYPE(cv, out); \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_flatten'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = (cv).size; \
+    TYPE_OF((out).data) _dst = vector_append_uninit(out, _n); \
+    if (UNLIKELY(_dst == NULL_PTR && _n != 0)) break; \
+    for (const VectorChunkLeaf *_leaf = (cv).first; _leaf != NULL_PTR; _leaf = _leaf->next) { \
+        memcpy((void *)_dst, private_vector_chunked_data(_leaf), _leaf->size * sizeof(*(cv).elem)); \
+        _dst += _leaf->size; \
+    } \
+} while(0)
+
+/**
+ * Removes every element and frees every leaf; the vector stays initialized.
+ */
+#define vector_chunked_clear(cv) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_chunked_clear'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_chunked_clear(&(cv), sizeof(*(cv).elem)); \
+} while(0)
+
+/**
+ * Frees every node.
+ * @param cv The chunked vector to destroy.
+ */
+#define vector_chunked_destroy(cv) do { \
+    if (private_vector_has_magic(cv, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_chunked_clear(&(cv), sizeof(*(cv).elem)); \
+    private_vector_set_magic(cv, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+#endif /* VECTOR_CHUNKED_H */
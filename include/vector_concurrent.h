@@ -0,0 +1,295 @@
+/*!
+    @file vector_concurrent.h header file
+    @brief  lock-free append-only vector for many producer threads.
+
+    Threads claim slots with one atomic fetch-add on `size` and write their
+    element in place, so no mutex is taken on the append path. Storage is a
+    table of segments that never move: segment 0 holds 2^shift elements and
+    segment k (k >= 1) holds 2^(shift + k - 1), so reaching index i needs one
+    CLZ and the table doubles the capacity with each new segment.
+
+    @details
+    - A segment is allocated by the first thread that needs it and published
+      with a compare-and-swap; a thread that loses the race frees its copy.
+    - Element addresses stay valid until `vector_concurrent_destroy`.
+    - `vector_concurrent_flatten` appends everything to a regular `vector(type)`
+      with one reservation and one memcpy per segment.
+
+    @example
+      vector_concurrent(Result) results;
+      vector_concurrent_init(results);
+      // on any number of threads:
+      vector_concurrent_push_back(results, r);
+      // after joining the producers:
+      vector(Result) out;
+      vector_init(out);
+      vector_concurrent_flatten(results, out);
+      vector_concurrent_destroy(results);
+
+    @warning
+    - `vector_concurrent_size` counts claimed slots. A slot is only readable
+      once the thread that claimed it is known to have finished its write
+      (e.g. after joining it); `vector_concurrent_at` and
+      `vector_concurrent_flatten` must not race with producers.
+    - Uses the GCC/Clang `__atomic` builtins (C and C++).
+*/
+
+#ifndef VECTOR_CONCURRENT_H
+#define VECTOR_CONCURRENT_H
+
+#include "vector.h"
+
+/* Elements in segment 0 are 2^VECTOR_CONCURRENT_FIRST_SHIFT. */
+#ifndef VECTOR_CONCURRENT_FIRST_SHIFT
+    #define VECTOR_CONCURRENT_FIRST_SHIFT 8
+#endif
+
+/* Segment table length; capacity is 2^(FIRST_SHIFT + SEGMENTS - 1) elements. */
+#ifndef VECTOR_CONCURRENT_SEGMENTS
+    #define VECTOR_CONCURRENT_SEGMENTS 48
+#endif
+
+#define VECTOR_CONCURRENT_FIELDS(type) \
+        type   *segments[VECTOR_CONCURRENT_SEGMENTS]; \
+        size_t  size; \
+        VECTOR_MAGIC_FIELD
+
+typedef struct {
+    VECTOR_CONCURRENT_FIELDS(void)
+} VectorConcurrentBase;
+
+/**
+ * @brief Declares an anonymous concurrent vector struct for the given type.
+ * @note  The field layout matches VectorConcurrentBase.
+ */
+#define vector_concurrent(type) \
+    struct { \
+        VECTOR_CONCURRENT_FIELDS(type) \
+    }
+
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_CONCURRENT_ASSERT_TRIVIAL(cv) \
+        static_assert( \
+            std::is_trivially_copyable<std::remove_pointer<TYPE_OF_VAL((cv).segments[0])>::type>::value, \
+            "vector_concurrent<T>: T must be trivially copyable" \
+        )
+#else
+    #define PRIVATE_VECTOR_CONCURRENT_ASSERT_TRIVIAL(cv) /* no-op in C */
+#endif
+
+/* !! PRIVATE !! — `out` must hold the element type of `cv` (in C only the sizes are compared, like VECTOR_ASSERT_SAME_TYPE) */
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_CONCURRENT_ASSERT_SAME_TYPE(cv, out) \
+        static_assert( \
+            std::is_same< \
+                typename std::remove_pointer<TYPE_OF((out).data)>::type, \
+                typename std::remove_pointer<TYPE_OF_VAL((cv).segments[0])>::type \
+            >::value, \
+            "vector_concurrent_flatten: out must store the same type" \
+        )
+#else
+    #define PRIVATE_VECTOR_CONCURRENT_ASSERT_SAME_TYPE(cv, out) \
+        _Static_assert( \
+            sizeof(*(out).data) == sizeof(*(cv).segments[0]), \
+            "vector_concurrent_flatten: element size mismatch" \
+        )
+#endif
+
+/* !! PRIVATE !! — Segment holding `index` */
+static inline size_t private_vector_concurrent_segment(size_t index)
+{
+    size_t i = index >> VECTOR_CONCURRENT_FIRST_SHIFT;
+    return i == 0 ? 0 : 64 - VECTOR_CLZ64(i);
+}
+
+/* !! PRIVATE !! — First index stored in segment `seg` */
+static inline size_t private_vector_concurrent_base(size_t seg)
+{
+    return seg == 0 ? 0 : (size_t)1 << (VECTOR_CONCURRENT_FIRST_SHIFT + seg - 1);
+}
+
+/* !! PRIVATE !! — Number of elements in segment `seg` */
+static inline size_t private_vector_concurrent_length(size_t seg)
+{
+    return (size_t)1 << (VECTOR_CONCURRENT_FIRST_SHIFT + (seg == 0 ? 0 : seg - 1));
+}
+
+/* !! PRIVATE !! — Returns segment `seg`, allocating and publishing it if needed; NULL on failure */
+static inline void *private_vector_concurrent_segment_ptr(VectorConcurrentBase *cv, size_t seg, size_t elem_size)
+{
+    void *p = __atomic_load_n(&cv->segments[seg], __ATOMIC_ACQUIRE);
+    if (LIKELY(p != NULL_PTR)) return p;
+
+    size_t bytes = private_vector_concurrent_length(seg) * elem_size;
+    void *fresh = private_vector_realloc(NULL_PTR, NULL_PTR, 0, bytes);
+    if (UNLIKELY(fresh == NULL_PTR)) return NULL_PTR;
+    if (__atomic_compare_exchange_n(&cv->segments[seg], &p, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return fresh;
+    private_vector_free(NULL_PTR, fresh, bytes);     /* another thread published first */
+    return p;
+}
+
+/* !! PRIVATE !! — Address of slot `index`, allocating its segment if needed; NULL on failure */
+static inline void *private_vector_concurrent_slot(void *cv_ptr, size_t index, size_t elem_size)
+{
+    VectorConcurrentBase *cv = (VectorConcurrentBase *)cv_ptr;
+    size_t seg = private_vector_concurrent_segment(index);
+    if (UNLIKELY(seg >= VECTOR_CONCURRENT_SEGMENTS)) return NULL_PTR;
+    char *p = (char *)private_vector_concurrent_segment_ptr(cv, seg, elem_size);
+    if (UNLIKELY(p == NULL_PTR)) return NULL_PTR;
+    return p + (index - private_vector_concurrent_base(seg)) * elem_size;
+}
+
+/**
+ * Initializes the concurrent vector. Not thread-safe; call before sharing it.
+ * @param cv The concurrent vector structure to initialize.
+ */
+#define vector_concurrent_init(cv) do { \
+    PRIVATE_VECTOR_CONCURRENT_ASSERT_TRIVIAL(cv); \
+    if (private_vector_has_magic(cv, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    memset((void *)(cv).segments, 0, sizeof((cv).segments)); \
+    (cv).size = 0; \
+    private_vector_set_magic(cv, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Appends value from any thread. Lock-free: one atomic fetch-add claims the slot.
+ * @param cv    The concurrent vector.
+ * @param value Element to append.
+ * @note Aborts if the slot's segment cannot be allocated or the vector is full:
+ *       the slot is already counted in `size` and cannot be given back.
+ */
+#define vector_concurrent_push_back(cv, value) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_concurrent_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _idx = __atomic_fetch_add(&(cv).size, (size_t)1, __ATOMIC_RELAXED); \
+    TYPE_OF_VAL((cv).segments[0]) _slot = (TYPE_OF_VAL((cv).segments[0])) \
+        private_vector_concurrent_slot(&(cv), _idx, sizeof(*(cv).segments[0])); \
+    if (UNLIKELY(_slot == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_concurrent_push_back'", __FILE__, __LINE__); \
+        CLIB_PREFIX abort(); \
+    } \
+    *_slot = (value); \
+} while(0)
+
+/**
+ * Pre-allocates the segments that hold the first `count` elements.
+ * @note Optional; avoids segment allocation on the append path. Safe to call concurrently.
+ */
+#define vector_concurrent_reserve(cv, count) do { \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_concurrent_reserve'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _cnt = (size_t)(count); \
+    if (_cnt == 0) break; \
+    size_t _last = private_vector_concurrent_segment(_cnt - 1); \
+    if (UNLIKELY(_last >= VECTOR_CONCURRENT_SEGMENTS)) { \
+        private_vector_fail("[x] Error: count exceeds capacity in 'vector_concurrent_reserve'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _s = 0; _s <= _last; _s++) { \
+        if (UNLIKELY(private_vector_concurrent_segment_ptr((VectorConcurrentBase *)&(cv), _s, \
+                                                           sizeof(*(cv).segments[0])) == NULL_PTR)) { \
+            private_vector_fail("[x] Error: allocation failed in 'vector_concurrent_reserve'", __FILE__, __LINE__); \
+            break; \
+        } \
+    } \
+} while(0)
+
+/**
+ * Returns the number of claimed slots (macro, size_t).
+ */
+#define vector_concurrent_size(cv) __atomic_load_n(&(cv).size, __ATOMIC_ACQUIRE)
+
+/* !! PRIVATE !! — Address of slot `index` if its segment exists, else NULL. Never allocates. */
+static inline void *private_vector_concurrent_lookup(const void *cv_ptr, size_t index, size_t elem_size)
+{
+    const VectorConcurrentBase *cv = (const VectorConcurrentBase *)cv_ptr;
+    size_t seg = private_vector_concurrent_segment(index);
+    if (UNLIKELY(seg >= VECTOR_CONCURRENT_SEGMENTS)) return NULL_PTR;
+    char *p = (char *)__atomic_load_n(&cv->segments[seg], __ATOMIC_ACQUIRE);
+    if (UNLIKELY(p == NULL_PTR)) return NULL_PTR;
+    return p + (index - private_vector_concurrent_base(seg)) * elem_size;
+}
+
+/**
+ * Returns a pointer to element `index` (macro, type*), or NULL_PTR if index >= size
+ * or its segment does not exist yet. Pure lookup: never allocates.
+ * Pointers stay valid until destroy.
+ * @warning Only for slots whose writers have finished (see the file notes).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_concurrent_at(cv, index) ({ \
+    TYPE_OF_VAL((cv).segments[0]) _elem = NULL_PTR; \
+    size_t _idx = (size_t)(index); \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_concurrent_at'", __FILE__, __LINE__); \
+    } else if (VECTOR_CHECK(_idx >= vector_concurrent_size(cv))) { \
+        private_vector_fail("[x] Error: index out of bounds in 'vector_concurrent_at'", __FILE__, __LINE__); \
+    } else { \
+        _elem = (TYPE_OF_VAL((cv).segments[0]))private_vector_concurrent_lookup(&(cv), _idx, sizeof(*(cv).segments[0])); \
+        if (UNLIKELY(_elem == NULL_PTR)) \
+            private_vector_fail("[x] Error: slot not written yet in 'vector_concurrent_at'", __FILE__, __LINE__); \
+    } \
+    _elem; \
+})
+
+/**
+ * Appends every element of the concurrent vector to a regular vector, in index order.
+ * @param cv  The concurrent vector (producers must have finished).
+ * @param out An initialized `vector(type)` with the same element type.
+ * @note One reservation on `out`, then one memcpy per segment.
+ */
+#define vector_concurrent_flatten(cv, out) do { \
+    PRIVATE_VECTOR_CONCURRENT_ASSERT_SAME_TYPE(cv, out); \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_concurrent_flatten'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = vector_concurrent_size(cv); \
+    TYPE_OF((out).data) _dst = vector_append_uninit(out, _n); \
+    if (UNLIKELY(_dst == NULL_PTR && _n != 0)) break; \
+    for (size_t _s = 0, _done = 0; _done < _n; _s++) { \
+        if (UNLIKELY(_s >= VECTOR_CONCURRENT_SEGMENTS || (cv).segments[_s] == NULL_PTR)) { \
+            /* Only reachable while producers still run: keep what is stored, drop the rest. */ \
+            private_vector_fail("[x] Error: missing segment in 'vector_concurrent_flatten'", __FILE__, __LINE__); \
+            (out).size -= _n - _done; \
+            break; \
+        } \
+        size_t _len = private_vector_concurrent_length(_s); \
+        if (_len > _n - _done) _len = _n - _done; \
+        memcpy(_dst + _done, (cv).segments[_s], _len * sizeof(*(cv).segments[0])); \
+        _done += _len; \
+    } \
+} while(0)
+
+/**
+ * Frees every segment. Not thread-safe; producers must have finished.
+ * @param cv The concurrent vector to destroy.
+ */
+#define vector_concurrent_destroy(cv) do { \
+    if (private_vector_has_magic(cv, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(cv))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _s = 0; _s < VECTOR_CONCURRENT_SEGMENTS; _s++) { \
+        private_vector_free(NULL_PTR, (cv).segments[_s], \
+                            private_vector_concurrent_length(_s) * sizeof(*(cv).segments[0])); \
+        (cv).segments[_s] = NULL_PTR; \
+    } \
+    (cv).size = 0; \
+    private_vector_set_magic(cv, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+#endif /* VECTOR_CONCURRENT_H */
@@ -0,0 +1,234 @@
+/*!
+    @file vector_cow.h header file
+    @brief  copy-on-write vectors: O(1) sharing of one buffer between many vectors.
+
+    A vector on a VectorCowAllocator keeps a small header with an atomic
+    reference count in front of its elements. `vector_share(dst, src)` makes
+    `dst` another reference to the same buffer without copying anything, so a
+    large read-mostly vector can be handed to many consumers for the cost of
+    one atomic increment each.
+
+    @details
+    - Both vectors of a share report capacity 0. The grow path of every
+      appending macro (vector_push_back, vector_insert, vector_insert_range,
+      vector_push_back_args, vector_append_uninit, vector_reserve) and
+      vector_resize to a non-zero size therefore reach the allocator first,
+      which copies the elements into a private buffer of the requested size and
+      drops the reference to the shared one. The copy happens once; afterwards
+      the vector grows in place like any other.
+    - If the other references are gone by then, the buffer is reallocated in
+      place instead of copied.
+    - vector_destroy drops a reference; the last one frees the buffer.
+    - Reference counting uses the GCC/Clang `__atomic` builtins, so vectors
+      sharing a buffer may live on different threads.
+
+    @example
+      VectorCowAllocator cow;
+      vector_cow_init(&cow, NULL);
+      vector(Row) table;
+      vector_init_with_allocator(table, vector_cow_allocator(&cow));
+      load_rows(&table);
+      for (int i = 0; i < n_workers; i++) {
+          memset(&views[i], 0, sizeof views[i]);
+          vector_share(views[i], table);             // O(1), no memcpy
+      }
+      vector_push_back(views[0], extra);            // views[0] copies once; the others are untouched
+
+    @warning
+    - A shared vector breaks the usual `capacity >= size` invariant on purpose
+      (capacity is 0). Safe on a shared vector: every read, vector_push_back,
+      vector_emplace_back, vector_push_back_args, vector_insert(_range/_args),
+      vector_append_uninit, vector_append_array, vector_extend(_gen),
+      vector_reserve(_exact) (any n: the new buffer never holds fewer than size
+      elements), vector_resize(_full/_uninit), vector_pop_back, vector_clear,
+      vector_shrink_to_fit (no-op), vector_swap and vector_destroy.
+    - Macros that write existing elements in place (vector_at / .data stores,
+      vector_erase, vector_erase_range, vector_swap_remove, vector_remove_if,
+      vector_remove_if_mask, vector_sort, vector_sort_custom, ...) do not
+      detach: call vector_unshare first. So do the *_unchecked pushes, which
+      rely on spare capacity.
+    - vector_release and vector_adopt must not be used on COW vectors: the
+      buffer starts inside a block with a header, not at a malloc pointer.
+    - `src` of vector_share must use a VectorCowAllocator; sharing any other
+      vector is undefined behavior.
+    - The VectorCowAllocator must outlive every vector that uses it.
+    - A single vector is not thread-safe; only the shared buffer's count is.
+*/
+
+#ifndef VECTOR_COW_H
+#define VECTOR_COW_H
+
+#include "vector.h"
+
+typedef struct {
+    VectorAllocator        allocator;
+    const VectorAllocator *base;    /* blocks come from here, NULL = VECTOR_REALLOC / VECTOR_FREE */
+} VectorCowAllocator;
+
+/* !! PRIVATE !! — Block header in front of the elements */
+typedef struct {
+    size_t refs;    /* vectors referencing the block (atomic) */
+    size_t bytes;   /* element bytes allocated after the header */
+    size_t used;    /* element bytes valid when the block was first shared */
+} VectorCowHeader;
+
+/* Element bytes start this far into the block (keeps malloc's 16-byte alignment). */
+#define VECTOR_COW_HEADER_SIZE ((sizeof(VectorCowHeader) + 15) & ~(size_t)15)
+
+/* !! PRIVATE !! — Do not call directly */
+static inline VectorCowHeader *private_vector_cow_header(const void *data)
+{
+    return (VectorCowHeader *)(void *)((char *)(uintptr_t)data - VECTOR_COW_HEADER_SIZE);
+}
+
+/* !! PRIVATE !! — Drops one reference; the last one frees the block */
+static inline void private_vector_cow_release(const VectorCowAllocator *cow, VectorCowHeader *h)
+{
+    if (__atomic_sub_fetch(&h->refs, 1, __ATOMIC_ACQ_REL) == 0)
+        private_vector_free(cow->base, h, VECTOR_COW_HEADER_SIZE + h->bytes);
+}
+
+/* !! PRIVATE !! — Do not call directly. Resizes a private block in place, copies a shared one. */
+static inline void *private_vector_cow_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    const VectorCowAllocator *cow = (const VectorCowAllocator *)ctx;
+    VectorCowHeader *h = NULL_PTR, *nh;
+    (void)old_size;     /* 0 for a shared vector; the header knows the real sizes */
+    if (UNLIKELY(new_size > SIZE_MAX - VECTOR_COW_HEADER_SIZE)) return NULL_PTR;
+
+    if (ptr != NULL_PTR) {
+        h = private_vector_cow_header(ptr);
+        if (__atomic_load_n(&h->refs, __ATOMIC_ACQUIRE) == 1) {
+            nh = (VectorCowHeader *)private_vector_realloc(cow->base, h, VECTOR_COW_HEADER_SIZE + h->bytes,
+                                                           VECTOR_COW_HEADER_SIZE + new_size);
+            if (UNLIKELY(nh == NULL_PTR)) return NULL_PTR;
+            nh->bytes = new_size;
+            return (char *)nh + VECTOR_COW_HEADER_SIZE;
+        }
+    }
+
+    nh = (VectorCowHeader *)private_vector_realloc(cow->base, NULL_PTR, 0, VECTOR_COW_HEADER_SIZE + new_size);
+    if (UNLIKELY(nh == NULL_PTR)) return NULL_PTR;
+    nh->refs  = 1;
+    nh->bytes = new_size;
+    nh->used  = 0;
+    if (ptr != NULL_PTR) {
+        /* Shared: take a private copy, then let go of the shared block. */
+        memcpy((char *)nh + VECTOR_COW_HEADER_SIZE, ptr, h->used < new_size ? h->used : new_size);
+        private_vector_cow_release(cow, h);
+    }
+    return (char *)nh + VECTOR_COW_HEADER_SIZE;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_cow_free(void *ctx, void *ptr, size_t size)
+{
+    (void)size;
+    if (ptr != NULL_PTR) private_vector_cow_release((const VectorCowAllocator *)ctx, private_vector_cow_header(ptr));
+}
+
+/* !! PRIVATE !! — Adds a reference for vector_share; `owner` = src held the block alone until now */
+static inline void private_vector_cow_retain(void *data, size_t used, int owner)
+{
+    VectorCowHeader *h = private_vector_cow_header(data);
+    if (owner) h->used = used;
+    __atomic_add_fetch(&h->refs, 1, __ATOMIC_RELAXED);
+}
+
+/* !! PRIVATE !! — vector_unshare; returns 0 on success, -1 if the private copy could not be allocated */
+static inline int private_vector_cow_unshare(void *vec_ptr, size_t elem_size, const char *file, int line)
+{
+    VectorBase *vec = (VectorBase *)vec_ptr;
+    if (vec->data == NULL_PTR || vec->capacity != 0) return 0;      /* owns its buffer already */
+    VectorCowHeader *h = private_vector_cow_header(vec->data);
+    if (__atomic_load_n(&h->refs, __ATOMIC_ACQUIRE) == 1) {         /* every other reference is gone */
+        vec->capacity = h->bytes / elem_size;
+        return 0;
+    }
+    if (vec->size == 0) {
+        private_vector_free(vec->allocator, vec->data, 0);
+        vec->data = NULL_PTR;
+        return 0;
+    }
+    return private_vector_reserve_base(vec, elem_size, vec->size, 1,
+        "[x] Error: allocation failed in 'vector_unshare'", file, line);
+}
+
+/**
+ * Initializes a copy-on-write allocator.
+ * @param cow  Pointer to the VectorCowAllocator to initialize.
+ * @param base Allocator the blocks come from (its growth policy is used too), or NULL for the default.
+ */
+static inline void vector_cow_init(VectorCowAllocator *cow, const VectorAllocator *base)
+{
+    cow->base = base;
+    cow->allocator.realloc_fn = private_vector_cow_realloc;
+    cow->allocator.free_fn    = private_vector_cow_free;
+    cow->allocator.ctx        = cow;
+    cow->allocator.growth     = base != NULL_PTR ? base->growth : NULL_PTR;
+}
+
+/**
+ * Returns the allocator to pass to `vector_init_with_allocator`.
+ */
+static inline const VectorAllocator *vector_cow_allocator(VectorCowAllocator *cow)
+{
+    return &cow->allocator;
+}
+
+/**
+ * Makes dst another reference to src's buffer. O(1): one atomic increment, no copy.
+ * dst is destroyed first if it is initialized; afterwards both vectors have
+ * capacity 0 (less than their size) until their first growth (which copies)
+ * or vector_unshare. See the file notes for the macros that are safe meanwhile.
+ * @param dst Vector of the same element type (initialized or not).
+ * @param src Vector on a VectorCowAllocator.
+ */
+#define vector_share(dst, src) do { \
+    (void)sizeof((dst).data == (src).data);     /* element types must match */ \
+    if (UNLIKELY(!vector_is_valid(src))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_share'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((void *)&(dst) == (void *)&(src)) break; \
+    if (vector_is_valid(dst)) vector_destroy(dst); \
+    vector_init_with_allocator(dst, (src).allocator); \
+    if ((src).data != NULL_PTR) { \
+        private_vector_cow_retain((void *)(src).data, (src).size * sizeof(*(src).data), (src).capacity != 0); \
+        (src).capacity = 0; \
+        (dst).data = (src).data; \
+        (dst).size = (src).size; \
+    } \
+} while (0)
+
+/**
+ * Gives the vector a buffer of its own before elements are written in place.
+ * No-op if it already owns one; O(1) if every other reference is gone; otherwise one copy.
+ * @return 0 on success, -1 on allocation failure (int; the vector still shares its buffer).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_unshare(vec) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_unshare'", __FILE__, __LINE__); \
+    } else { \
+        _rc = private_vector_cow_unshare(&(vec), sizeof(*(vec).data), __FILE__, __LINE__); \
+    } \
+    _rc; \
+})
+
+/**
+ * Number of vectors referencing this vector's buffer (size_t; 0 without a buffer).
+ * Only for vectors on a VectorCowAllocator.
+ */
+#define vector_share_count(vec) \
+    ((vec).data == NULL_PTR ? (size_t)0 \
+        : __atomic_load_n(&private_vector_cow_header((vec).data)->refs, __ATOMIC_ACQUIRE))
+
+/**
+ * Whether the buffer is referenced by another vector too (int).
+ */
+#define vector_is_shared(vec) (vector_share_count(vec) > 1)
+
+#endif /* VECTOR_COW_H */
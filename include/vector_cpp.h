@@ -0,0 +1,281 @@
+/*!
+    @file vector_cpp.h header file
+    @brief  cvector<T>: C++ RAII wrapper over the vector layout, for any element type.
+
+    cvector<T> has exactly the fields of a `vector(T)` (data, size, capacity,
+    allocator, magic), so it stays binary-compatible with VectorBase and can be
+    handed to the type-erased helpers. On top of that it adds:
+    - a destructor that destroys the elements and frees the buffer;
+    - move construction/assignment (pointer steal, the source is left empty);
+    - deep copy construction/assignment;
+    - growth that keeps the realloc fast path for trivially relocatable types
+      and move-constructs elements into a new block for everything else.
+
+    @details
+    - `vector_trivially_relocatable<T>` decides the growth path. It defaults to
+      std::is_trivially_copyable; specialize it to std::true_type for types that
+      survive a memcpy to a new address (e.g. most std::unique_ptr, or a struct
+      with no self-pointers) to get realloc growth for them too.
+    - Capacity follows the allocator's growth policy, as for the C macros.
+    - Allocation failure throws std::bad_alloc (aborts with -fno-exceptions).
+    - at() is bounds-checked like vector_at; operator[] is not.
+
+    @example
+      cvector<std::string> names;
+      names.push_back("ada");
+      names.emplace_back(3, 'x');
+      cvector<std::string> moved = std::move(names);   // O(1), names is now empty
+      for (const std::string &s : moved) puts(s.c_str());
+
+    @warning
+    - The C macros (vector_push_back, vector_sort, ...) may be used on a cvector<T>
+      only when T is trivially copyable; they never run constructors.
+    - Elements whose alignment exceeds alignof(std::max_align_t) need an allocator
+      that provides it (see vector_aligned_allocator).
+*/
+
+#ifndef VECTOR_CPP_H
+#define VECTOR_CPP_H
+
+#ifndef __cplusplus
+    #error "vector_cpp.h requires a C++11 compiler"
+#endif
+
+#include "vector.h"
+
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Whether T may be moved to a new address with memcpy/realloc.
+ *        Specialize with std::true_type for relocatable types that are not trivially copyable.
+ */
+template <typename T>
+struct vector_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+/* !! PRIVATE !! — Reports an allocation failure */
+[[noreturn]] static inline void private_vector_cpp_bad_alloc(const char *msg)
+{
+    (void)msg;      /* unused when exceptions are on or diagnostics are compiled out */
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    throw std::bad_alloc();
+#else
+    private_vector_fail(msg, __FILE__, __LINE__);
+    CLIB_PREFIX abort();
+#endif
+}
+
+template <typename T>
+struct cvector {
+    VECTOR_FIELDS(T)
+
+    typedef T        value_type;
+    typedef T       *iterator;
+    typedef const T *const_iterator;
+
+    cvector() noexcept { private_init(NULL_PTR); }
+
+    /** Empty vector whose growth, shrink and free go through `alloc`. */
+    explicit cvector(const VectorAllocator *alloc) noexcept { private_init(alloc); }
+
+    cvector(std::initializer_list<T> items) : cvector()
+    {
+        reserve(items.size());
+        for (const T &item : items) new (data + size++) T(item);
+    }
+
+    cvector(const cvector &other) : cvector(other.allocator)
+    {
+        reserve(other.size);
+        for (; size < other.size; size++) new (data + size) T(other.data[size]);
+    }
+
+    cvector(cvector &&other) noexcept
+    {
+        data      = other.data;
+        size      = other.size;
+        capacity  = other.capacity;
+        allocator = other.allocator;
+        private_vector_set_magic(*this, VECTOR_MAGIC_INIT);
+        other.data     = NULL_PTR;
+        other.size     = 0;
+        other.capacity = 0;
+    }
+
+    cvector &operator=(const cvector &other)
+    {
+        if (this != &other) {
+            cvector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    cvector &operator=(cvector &&other) noexcept
+    {
+        if (this != &other) {
+            cvector dead(std::move(other));
+            swap(dead);
+        }
+        return *this;
+    }
+
+    ~cvector()
+    {
+        clear();
+        private_vector_free(allocator, data, capacity * sizeof(T));
+        data     = NULL_PTR;
+        capacity = 0;
+        private_vector_set_magic(*this, VECTOR_MAGIC_DESTROYED);
+    }
+
+    void swap(cvector &other) noexcept
+    {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        std::swap(allocator, other.allocator);
+    }
+
+    bool           empty() const noexcept   { return size == 0; }
+    iterator       begin() noexcept         { return data; }
+    iterator       end() noexcept           { return data + size; }
+    const_iterator begin() const noexcept   { return data; }
+    const_iterator end() const noexcept     { return data + size; }
+
+    T       &operator[](size_t index) noexcept       { return data[index]; }
+    const T &operator[](size_t index) const noexcept { return data[index]; }
+    T       &at(size_t index)       { return vector_at(*this, index); }
+    const T &at(size_t index) const { return vector_at(*this, index); }
+    T       &front()                { return vector_front(*this); }
+    T       &back()                 { return vector_back(*this); }
+
+    /** Constructs an element in place at the end. The arguments may refer to elements of this vector. */
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (UNLIKELY(size == capacity)) {
+            T tmp(std::forward<Args>(args)...);
+            private_grow(private_vector_grow_capacity(*this, size + 1));
+            new (data + size) T(std::move(tmp));
+        } else {
+            new (data + size) T(std::forward<Args>(args)...);
+        }
+        return data[size++];
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value)      { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        if (VECTOR_CHECK(size == 0)) {
+            private_vector_fail("[x] Error: 'vector_pop_back' on empty vector", __FILE__, __LINE__);
+            return;
+        }
+        data[--size].~T();
+    }
+
+    /** Removes the element at position, shifting the tail down by one. */
+    void erase(size_t position)
+    {
+        if (VECTOR_CHECK(position >= size)) {
+            private_vector_fail("[x] Error: position out of bounds in 'vector_erase'", __FILE__, __LINE__);
+            return;
+        }
+        for (size_t i = position; i + 1 < size; i++) data[i] = std::move(data[i + 1]);
+        data[--size].~T();
+    }
+
+    /** Destroys every element; capacity is unchanged. */
+    void clear() noexcept
+    {
+        private_destroy(data, size);
+        size = 0;
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity) private_grow(private_vector_padded_capacity(*this, new_capacity));
+    }
+
+    void resize(size_t new_size)                 { private_resize(new_size, [this] { new (data + size) T(); }); }
+    void resize(size_t new_size, const T &value) { private_resize(new_size, [&] { new (data + size) T(value); }); }
+
+    void shrink_to_fit()
+    {
+        size_t fit = private_vector_padded_capacity(*this, size);
+        if (fit < capacity) private_grow(fit);
+    }
+
+    /* !! PRIVATE !! — Implementation details below */
+    void private_init(const VectorAllocator *alloc) noexcept
+    {
+        data      = NULL_PTR;
+        size      = 0;
+        capacity  = 0;
+        allocator = alloc;
+        private_vector_set_magic(*this, VECTOR_MAGIC_INIT);
+    }
+
+    static void private_destroy(T *first, size_t count) noexcept
+    {
+        if (!std::is_trivially_destructible<T>::value)
+            for (size_t i = 0; i < count; i++) first[i].~T();
+    }
+
+    template <typename Construct>
+    void private_resize(size_t new_size, Construct construct)
+    {
+        if (new_size < size) {
+            private_destroy(data + new_size, size - new_size);
+            size = new_size;
+            return;
+        }
+        reserve(new_size);
+        for (; size < new_size; size++) construct();
+    }
+
+    /* Moves the elements into a block of new_cap elements (new_cap >= size). */
+    void private_grow(size_t new_cap)
+    {
+        if (UNLIKELY(new_cap > SIZE_MAX / sizeof(T))) private_vector_cpp_bad_alloc("[x] Error: allocation failed in 'cvector'");
+        if (new_cap == 0) {                     /* only reached with size == 0 */
+            private_vector_free(allocator, data, capacity * sizeof(T));
+            data = NULL_PTR;
+        } else if (vector_trivially_relocatable<T>::value) {
+            void *nd = private_vector_realloc(allocator, data, capacity * sizeof(T), new_cap * sizeof(T));
+            if (UNLIKELY(nd == NULL_PTR)) private_vector_cpp_bad_alloc("[x] Error: allocation failed in 'cvector'");
+            data = static_cast<T *>(nd);
+        } else {
+            T *nd = static_cast<T *>(private_vector_realloc(allocator, NULL_PTR, 0, new_cap * sizeof(T)));
+            if (UNLIKELY(nd == NULL_PTR)) private_vector_cpp_bad_alloc("[x] Error: allocation failed in 'cvector'");
+            size_t done = 0;
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+            try {
+                for (; done < size; done++) new (nd + done) T(std::move_if_noexcept(data[done]));
+            } catch (...) {
+                private_destroy(nd, done);
+                private_vector_free(allocator, nd, new_cap * sizeof(T));
+                throw;
+            }
+#else
+            for (; done < size; done++) new (nd + done) T(std::move(data[done]));
+#endif
+            private_destroy(data, size);
+            private_vector_free(allocator, data, capacity * sizeof(T));
+            data = nd;
+        }
+        capacity = new_cap;
+    }
+};
+
+static_assert(sizeof(cvector<int>) == sizeof(VectorBase) &&
+              offsetof(cvector<int>, data) == offsetof(VectorBase, data) &&
+              offsetof(cvector<int>, size) == offsetof(VectorBase, size) &&
+              offsetof(cvector<int>, capacity) == offsetof(VectorBase, capacity) &&
+              offsetof(cvector<int>, allocator) == offsetof(VectorBase, allocator),
+              "cvector<T>: layout must match VectorBase");
+
+#endif /* VECTOR_CPP_H */
@@ -0,0 +1,418 @@
+/*!
+    @file vector_deque.h header file
+    @brief  ring-buffer deque and a lock-free single-producer/single-consumer queue.
+
+    `vector_deque(type)` keeps its elements in a power-of-two ring: `head` is
+    the slot of the first element and slot i of the deque is
+    `data[(head + i) & (capacity - 1)]`. push/pop at either end are O(1);
+    growing doubles the ring and moves only the shorter wrapped segment.
+    `vector_deque_linearize` rotates the ring so the elements are contiguous
+    (e.g. to hand them to vector_view_init or a write call).
+
+    `vector_spsc(type)` is a fixed-capacity ring for passing work from exactly
+    one producer thread to exactly one consumer thread without locks: each side
+    owns one index on its own cache line and reads the other's with acquire
+    loads only when its cached copy says the ring looks full/empty.
+
+    @example
+      vector_deque(Job) q;
+      vector_deque_init(q);
+      vector_deque_push_back(q, job);
+      Job next = vector_deque_front(q);
+      vector_deque_pop_front(q);
+      vector_deque_destroy(q);
+
+      vector_spsc(Job) pipe;
+      vector_spsc_init(pipe, 1024);
+      // producer:                          // consumer:
+      while (!vector_spsc_try_push(pipe, j)) ;    Job j; if (vector_spsc_try_pop(pipe, &j)) ...
+
+    @warning
+    - A vector_deque is not thread-safe; vector_spsc is safe for one producer and
+      one consumer only.
+    - vector_spsc uses the GCC/Clang `__atomic` builtins (C and C++).
+*/
+
+#ifndef VECTOR_DEQUE_H
+#define VECTOR_DEQUE_H
+
+#include "vector.h"
+
+/* Capacity of the first ring allocation (rounded up to a power of two). */
+#ifndef VECTOR_DEQUE_MIN_CAPACITY
+    #define VECTOR_DEQUE_MIN_CAPACITY 8
+#endif
+
+/**
+ * @section Deque
+ * -------------------------------------------------------------------------
+ */
+#define VECTOR_DEQUE_FIELDS(type) \
+        type                  *data; \
+        size_t                 head;        /* slot of the first element */ \
+        size_t                 size; \
+        size_t                 capacity;    /* 0 or a power of two */ \
+        const VectorAllocator *allocator; \
+        VECTOR_MAGIC_FIELD
+
+/**
+ * @brief Declares an anonymous ring-buffer deque struct for the given type.
+ */
+#define vector_deque(type) \
+    struct { \
+        VECTOR_DEQUE_FIELDS(type) \
+    }
+
+/* !! PRIVATE !! — Smallest power of two >= n (n >= 1) */
+static inline size_t private_vector_deque_pow2(size_t n)
+{
+    return n <= 1 ? 1 : (size_t)1 << (64 - VECTOR_CLZ64((uint64_t)(n - 1)));
+}
+
+/* !! PRIVATE !! — Grows the ring to a power of two >= needed, keeping the element order; 0 on success */
+static inline int private_vector_deque_grow
+(
+    void **data, size_t *head, size_t size, size_t *capacity,
+    size_t needed, size_t elem_size, const VectorAllocator *alloc
+)
+{
+    size_t cap = *capacity;
+    if (needed <= cap) return 0;
+    size_t nc = private_vector_deque_pow2(needed < VECTOR_DEQUE_MIN_CAPACITY ? VECTOR_DEQUE_MIN_CAPACITY : needed);
+    if (UNLIKELY(nc < needed || nc > SIZE_MAX / elem_size)) return -1;
+    char *nd = (char *)private_vector_realloc(alloc, *data, cap * elem_size, nc * elem_size);
+    if (UNLIKELY(nd == NULL_PTR)) return -1;
+
+    size_t first = cap - *head;             /* elements in [head, cap) */
+    if (size > first) {                     /* wrapped: move the shorter segment */
+        size_t second = size - first;       /* elements in [0, second) */
+        if (second <= first && second <= nc - cap) {
+            memcpy(nd + cap * elem_size, nd, second * elem_size);
+        } else {
+            memmove(nd + (nc - first) * elem_size, nd + *head * elem_size, first * elem_size);
+            *head = nc - first;
+        }
+    }
+    *data     = nd;
+    *capacity = nc;
+    return 0;
+}
+
+/* !! PRIVATE !! — Reverses `count` elements of `elem_size` bytes starting at p */
+static inline void private_vector_deque_reverse(char *p, size_t count, size_t elem_size)
+{
+    if (count < 2) return;
+    char *a = p, *b = p + (count - 1) * elem_size;
+    for (; a < b; a += elem_size, b -= elem_size)
+        for (size_t k = 0; k < elem_size; k++) { char t = a[k]; a[k] = b[k]; b[k] = t; }
+}
+
+/* !! PRIVATE !! — Makes the ring contiguous from slot 0; returns the new data pointer */
+static inline void *private_vector_deque_linearize
+(
+    void *data, size_t *head, size_t size, size_t capacity,
+    size_t elem_size, const VectorAllocator *alloc
+)
+{
+    char *d = (char *)data;
+    if (*head + size <= capacity) return d + *head * elem_size;      /* already contiguous */
+
+    size_t first = capacity - *head, second = size - first;
+    char *nd = (char *)private_vector_realloc(alloc, NULL_PTR, 0, capacity * elem_size);
+    if (nd != NULL_PTR) {
+        memcpy(nd, d + *head * elem_size, first * elem_size);
+        memcpy(nd + first * elem_size, d, second * elem_size);
+        private_vector_free(alloc, d, capacity * elem_size);
+        *head = 0;
+        return nd;
+    }
+    /* No memory for a copy: rotate left by head in place (three reversals). */
+    private_vector_deque_reverse(d, *head, elem_size);
+    private_vector_deque_reverse(d + *head * elem_size, first, elem_size);
+    private_vector_deque_reverse(d, capacity, elem_size);
+    *head = 0;
+    return d;
+}
+
+/* !! PRIVATE !! — Ring slot of deque index i */
+#define private_vector_deque_slot(dq, i) (((dq).head + (size_t)(i)) & ((dq).capacity - 1))
+
+/**
+ * Initializes the deque. No memory is allocated until the first push.
+ */
+#define vector_deque_init(dq) do { \
+    VECTOR_ASSERT_TRIVIAL(dq); \
+    if (private_vector_has_magic(dq, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).data      = NULL_PTR; \
+    (dq).head      = 0; \
+    (dq).size      = 0; \
+    (dq).capacity  = 0; \
+    (dq).allocator = NULL_PTR; \
+    private_vector_set_magic(dq, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Initializes the deque with a custom VectorAllocator (its growth policy is not used:
+ * the ring always doubles).
+ */
+#define vector_deque_init_with_allocator(dq, alloc) do { \
+    vector_deque_init(dq); \
+    (dq).allocator = (alloc); \
+} while(0)
+
+#define vector_deque_size(dq)       ((dq).size)
+#define vector_deque_capacity(dq)   ((dq).capacity)
+#define vector_deque_empty(dq)      ((dq).size == 0)
+
+/* !! PRIVATE !! — Ensures room for one more element; evaluates to 0 on success */
+#define private_vector_deque_make_room(dq) \
+    (LIKELY((dq).size < (dq).capacity) ? 0 : \
+     private_vector_deque_grow((void **)&(dq).data, &(dq).head, (dq).size, &(dq).capacity, \
+                               (dq).size + 1, sizeof(*(dq).data), (dq).allocator))
+
+/**
+ * Reserves room for at least new_capacity elements (rounded up to a power of two).
+ */
+#define vector_deque_reserve(dq, new_capacity) do { \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_deque_reserve'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (private_vector_deque_grow((void **)&(dq).data, &(dq).head, (dq).size, &(dq).capacity, \
+                                  (size_t)(new_capacity), sizeof(*(dq).data), (dq).allocator) != 0) \
+        private_vector_fail("[x] Error: allocation failed in 'vector_deque_reserve'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Appends value at the back. O(1) amortized.
+ */
+#define vector_deque_push_back(dq, value) do { \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_deque_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(private_vector_deque_make_room(dq) != 0)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_deque_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).data[private_vector_deque_slot(dq, (dq).size)] = (value); \
+    (dq).size++; \
+} while(0)
+
+/**
+ * Prepends value at the front. O(1) amortized.
+ */
+#define vector_deque_push_front(dq, value) do { \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_deque_push_front'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(private_vector_deque_make_room(dq) != 0)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_deque_push_front'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).head = ((dq).head - 1) & ((dq).capacity - 1); \
+    (dq).data[(dq).head] = (value); \
+    (dq).size++; \
+} while(0)
+
+/**
+ * Removes the first element. O(1).
+ */
+#define vector_deque_pop_front(dq) do { \
+    if (VECTOR_CHECK(!vector_is_valid(dq) || (dq).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_deque_pop_front' on empty/uninitialized deque", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).head = ((dq).head + 1) & ((dq).capacity - 1); \
+    (dq).size--; \
+} while(0)
+
+/**
+ * Removes the last element. O(1).
+ */
+#define vector_deque_pop_back(dq) do { \
+    if (VECTOR_CHECK(!vector_is_valid(dq) || (dq).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_deque_pop_back' on empty/uninitialized deque", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).size--; \
+} while(0)
+
+#ifdef VECTOR_UNCHECKED
+    #define vector_deque_at(dq, index)  ((dq).data[private_vector_deque_slot(dq, index)])
+#else
+/**
+ * @brief Bounds-checked access to element `index` from the front (lvalue).
+ */
+#define vector_deque_at(dq, index) \
+    ((vector_is_valid(dq) && (size_t)(index) < (dq).size) ? \
+     (dq).data[private_vector_deque_slot(dq, index)] : \
+     (private_vector_fail("[x] Error: out-of-bounds access", __FILE__, __LINE__), \
+      abort(), VECTOR_UNREACHABLE(), (dq).data[0]))
+#endif
+
+#define vector_deque_front(dq)  vector_deque_at(dq, 0)
+#define vector_deque_back(dq)   vector_deque_at(dq, (dq).size - 1)
+
+/**
+ * Rotates the ring so the elements sit contiguously at data[0 .. size).
+ * @return (type*) Pointer to the first element (NULL for an empty deque). Valid until the next push.
+ * @note O(size) when the ring is wrapped (one extra buffer, or in place if that allocation fails), O(1) otherwise.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_deque_linearize(dq) ({ \
+    TYPE_OF((dq).data) _first = NULL_PTR; \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_deque_linearize'", __FILE__, __LINE__); \
+    } else if ((dq).size != 0) { \
+        _first = (TYPE_OF((dq).data))private_vector_deque_linearize((dq).data, &(dq).head, (dq).size, \
+                                                                    (dq).capacity, sizeof(*(dq).data), (dq).allocator); \
+        (dq).data = _first - (dq).head; \
+    } \
+    _first; \
+})
+
+/**
+ * Removes every element without freeing memory.
+ */
+#define vector_deque_clear(dq) do { \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_deque_clear'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (dq).head = 0; \
+    (dq).size = 0; \
+} while(0)
+
+/**
+ * Frees the ring and marks the deque destroyed.
+ */
+#define vector_deque_destroy(dq) do { \
+    if (private_vector_has_magic(dq, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(dq))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_free((dq).allocator, (dq).data, (dq).capacity * sizeof(*(dq).data)); \
+    (dq).data     = NULL_PTR; \
+    (dq).head     = 0; \
+    (dq).size     = 0; \
+    (dq).capacity = 0; \
+    private_vector_set_magic(dq, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+/**
+ * @section SPSC Queue
+ * -------------------------------------------------------------------------
+ * Indices only grow; slot = index & mask. The producer writes `tail`, the
+ * consumer writes `head`, each on its own cache line next to its cached copy
+ * of the other index.
+ */
+#define vector_spsc(type) \
+    struct { \
+        type                  *data; \
+        size_t                 mask;        /* capacity - 1 */ \
+        const VectorAllocator *allocator; \
+        VECTOR_MAGIC_FIELD \
+        VECTOR_ALIGNAS(VECTOR_CACHE_LINE) size_t tail;      /* producer */ \
+        size_t                 head_cache; \
+        VECTOR_ALIGNAS(VECTOR_CACHE_LINE) size_t head;      /* consumer */ \
+        size_t                 tail_cache; \
+    }
+
+/**
+ * Allocates a queue for at least `capacity` elements (rounded up to a power of two).
+ * Not thread-safe; call before starting the producer and consumer.
+ */
+#define vector_spsc_init(q, capacity) do { \
+    VECTOR_ASSERT_TRIVIAL(q); \
+    if (private_vector_has_magic(q, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _cap = private_vector_deque_pow2((size_t)(capacity)); \
+    (q).allocator  = NULL_PTR; \
+    (q).data       = (TYPE_OF((q).data))private_vector_realloc(NULL_PTR, NULL_PTR, 0, _cap * sizeof(*(q).data)); \
+    if (UNLIKELY((q).data == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_spsc_init'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (q).mask       = _cap - 1; \
+    (q).tail       = 0; \
+    (q).head_cache = 0; \
+    (q).head       = 0; \
+    (q).tail_cache = 0; \
+    private_vector_set_magic(q, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Producer only. Enqueues value if there is room.
+ * @return 1 if enqueued, 0 if the queue is full (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_spsc_try_push(q, value) ({ \
+    int _ok = 0; \
+    size_t _t = (q).tail; \
+    if (_t - (q).head_cache <= (q).mask || \
+        _t - ((q).head_cache = __atomic_load_n(&(q).head, __ATOMIC_ACQUIRE)) <= (q).mask) { \
+        (q).data[_t & (q).mask] = (value); \
+        __atomic_store_n(&(q).tail, _t + 1, __ATOMIC_RELEASE); \
+        _ok = 1; \
+    } \
+    _ok; \
+})
+
+/**
+ * Consumer only. Dequeues the oldest element into *out if there is one.
+ * @return 1 if an element was dequeued, 0 if the queue is empty (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_spsc_try_pop(q, out) ({ \
+    int _ok = 0; \
+    size_t _h = (q).head; \
+    if (_h != (q).tail_cache || \
+        _h != ((q).tail_cache = __atomic_load_n(&(q).tail, __ATOMIC_ACQUIRE))) { \
+        *(out) = (q).data[_h & (q).mask]; \
+        __atomic_store_n(&(q).head, _h + 1, __ATOMIC_RELEASE); \
+        _ok = 1; \
+    } \
+    _ok; \
+})
+
+/**
+ * Elements currently queued (macro, size_t). Exact only when neither side is running.
+ */
+#define vector_spsc_size(q) \
+    (__atomic_load_n(&(q).tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&(q).head, __ATOMIC_ACQUIRE))
+
+#define vector_spsc_capacity(q) ((q).mask + 1)
+
+/**
+ * Frees the queue. Both threads must have stopped using it.
+ */
+#define vector_spsc_destroy(q) do { \
+    if (private_vector_has_magic(q, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(q))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_free((q).allocator, (q).data, ((q).mask + 1) * sizeof(*(q).data)); \
+    (q).data = NULL_PTR; \
+    (q).mask = 0; \
+    private_vector_set_magic(q, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+#endif /* VECTOR_DEQUE_H */
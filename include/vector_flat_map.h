@@ -0,0 +1,383 @@
+/*!
+    @file vector_flat_map.h header file
+    @brief  sorted flat map / flat set stored in contiguous vector columns.
+
+    `vector_flat_map(key_type, value_type)` keeps its keys sorted in one
+    vector(key_type) and the matching values in a parallel vector(value_type);
+    `vector_flat_set(key_type)` is the keys column alone. For small and medium
+    tables this costs no per-node memory and a lookup touches O(log N) cache
+    lines of keys only.
+
+    @details
+    - Keys are ordered with `<` (integers, floating point without NaN, pointers);
+      two keys are equal when neither is less than the other.
+    - Lookup is the branchless binary search of vector_lower_bound.
+    - insert / erase shift both columns with memmove, like vector_insert: O(N).
+    - Bulk construction: push_unsorted then build (sort + dedup, last pushed wins),
+      O(N log N) once instead of N memmoves.
+    - insert_many sorts the batch and merges it into the table from the back in
+      one pass: every existing element moves at most once.
+    - The columns are plain vectors: iterate `m.keys.data[i]` / `m.values.data[i]`
+      for i < vector_flat_map_size(m).
+
+    @example
+      vector_flat_map(uint32_t, float) price;
+      vector_flat_map_init(price);
+      vector_flat_map_insert(price, 42u, 9.5f);
+      float *p = vector_flat_map_get(price, 42u);      // NULL if absent
+      vector_flat_map_destroy(price);
+
+    @warning
+    - Pointers returned by vector_flat_map_get are invalidated by any insert or erase.
+*/
+
+#ifndef VECTOR_FLAT_MAP_H
+#define VECTOR_FLAT_MAP_H
+
+#include "vector.h"
+
+#define vector_flat_map(key_type, value_type) \
+    struct { \
+        vector(key_type)   keys;    /* sorted, unique */ \
+        vector(value_type) values;  /* values.data[i] belongs to keys.data[i] */ \
+    }
+
+#define vector_flat_set(key_type) \
+    struct { \
+        vector(key_type) keys;      /* sorted, unique */ \
+    }
+
+/* !! PRIVATE !! — Orders (key, index) pairs by key, then by insertion index */
+#define PRIVATE_VECTOR_FLAT_PAIR_LESS(a, b) \
+    ((a).pk < (b).pk || (!((b).pk < (a).pk) && (a).pi < (b).pi))
+
+/* !! PRIVATE !! — Sorts n (pk, pi) pairs and keeps the last of each equal-key run; leaves the count in out_n */
+#define PRIVATE_VECTOR_FLAT_SORT_PAIRS(pairs, n, out_n) do { \
+    PRIVATE_VECTOR_INTROSORT(pairs, n, PRIVATE_VECTOR_FLAT_PAIR_LESS); \
+    size_t _sw = 0; \
+    for (size_t _sr = 0; _sr < (n); _sr++) { \
+        if (_sr + 1 < (n) && !((pairs)[_sr].pk < (pairs)[_sr + 1].pk)) continue; \
+        (pairs)[_sw++] = (pairs)[_sr]; \
+    } \
+    (out_n) = _sw; \
+} while(0)
+
+/* !! PRIVATE !! — Sorts n keys and drops repeats; leaves the count in out_n */
+#define PRIVATE_VECTOR_FLAT_SORT_KEYS(keys_ptr, n, out_n) do { \
+    PRIVATE_VECTOR_INTROSORT(keys_ptr, n, PRIVATE_VECTOR_LESS); \
+    size_t _sw = 0; \
+    for (size_t _sr = 0; _sr < (n); _sr++) \
+        if (_sw == 0 || (keys_ptr)[_sw - 1] < (keys_ptr)[_sr]) (keys_ptr)[_sw++] = (keys_ptr)[_sr]; \
+    (out_n) = _sw; \
+} while(0)
+
+/* !! PRIVATE !! — Number of keys in sorted unique a[0, na) that also occur in sorted unique b[0, nb) */
+#define PRIVATE_VECTOR_FLAT_COMMON(a, na, b, nb, b_key) ({ \
+    size_t _ca = 0, _cb = 0, _common = 0; \
+    while (_ca < (na) && _cb < (nb)) { \
+        if      ((a)[_ca] < b_key((b)[_cb])) _ca++; \
+        else if (b_key((b)[_cb]) < (a)[_ca]) _cb++; \
+        else { _ca++; _cb++; _common++; } \
+    } \
+    _common; \
+})
+
+#define PRIVATE_VECTOR_FLAT_PAIR_KEY(p) ((p).pk)
+#define PRIVATE_VECTOR_FLAT_SELF(k)     (k)
+
+/**
+ * @section Flat Map
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * Initializes an empty map.
+ */
+#define vector_flat_map_init(m) do { \
+    vector_init((m).keys); \
+    vector_init((m).values); \
+} while(0)
+
+/**
+ * Initializes an empty map whose columns use a custom VectorAllocator.
+ */
+#define vector_flat_map_init_with_allocator(m, alloc) do { \
+    vector_init_with_allocator((m).keys, alloc); \
+    vector_init_with_allocator((m).values, alloc); \
+} while(0)
+
+#define vector_flat_map_size(m)     ((m).keys.size)
+#define vector_flat_map_empty(m)    ((m).keys.size == 0)
+
+/**
+ * Reserves room for count entries in both columns.
+ */
+#define vector_flat_map_reserve(m, count) do { \
+    vector_reserve((m).keys, count); \
+    vector_reserve((m).values, count); \
+} while(0)
+
+/**
+ * Index of key, or -1 (ptrdiff_t). O(log N).
+ */
+#define vector_flat_map_find(m, key) vector_binary_search((m).keys, key)
+
+#define vector_flat_map_contains(m, key) (vector_flat_map_find(m, key) >= 0)
+
+/**
+ * Pointer to the value stored for key, or NULL (value_type*).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_flat_map_get(m, key) ({ \
+    ptrdiff_t _fg = vector_flat_map_find(m, key); \
+    TYPE_OF((m).values.data) _fv = NULL_PTR; \
+    if (_fg >= 0) _fv = &(m).values.data[_fg]; \
+    _fv; \
+})
+
+/**
+ * Inserts key -> value, or assigns value if key is already present. O(N) memmove.
+ */
+#define vector_flat_map_insert(m, key, value) do { \
+    if (UNLIKELY(!vector_is_valid((m).keys) || !vector_is_valid((m).values))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_flat_map_insert'", __FILE__, __LINE__); \
+        break; \
+    } \
+    TYPE_OF_VAL(*(m).keys.data) _fk = (key); \
+    size_t _fp = vector_lower_bound((m).keys, _fk); \
+    if (_fp < (m).keys.size && !(_fk < (m).keys.data[_fp])) { \
+        (m).values.data[_fp] = (value); \
+        break; \
+    } \
+    size_t _fn = (m).keys.size; \
+    vector_insert((m).keys, _fp, _fk); \
+    if (UNLIKELY((m).keys.size == _fn)) break; \
+    vector_insert((m).values, _fp, (value)); \
+    if (UNLIKELY((m).values.size == _fn)) vector_erase((m).keys, _fp);    /* keep the columns aligned */ \
+} while(0)
+
+/**
+ * Removes key if present.
+ * @return 1 if an entry was removed, 0 otherwise (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_flat_map_erase(m, key) ({ \
+    int _fe = 0; \
+    ptrdiff_t _fi = vector_flat_map_find(m, key); \
+    if (_fi >= 0) { \
+        vector_erase((m).keys, (size_t)_fi); \
+        vector_erase((m).values, (size_t)_fi); \
+        _fe = 1; \
+    } \
+    _fe; \
+})
+
+/**
+ * Appends key -> value without keeping the order. Call vector_flat_map_build before any lookup.
+ */
+#define vector_flat_map_push_unsorted(m, key, value) do { \
+    size_t _fn = (m).keys.size; \
+    vector_push_back((m).keys, key); \
+    if (UNLIKELY((m).keys.size == _fn)) break; \
+    vector_push_back((m).values, value); \
+    if (UNLIKELY((m).values.size == _fn)) (m).keys.size = _fn; \
+} while(0)
+
+/**
+ * Sorts the entries by key and removes duplicate keys; for each key the value pushed last is kept.
+ * O(N log N), one temporary buffer per column.
+ */
+#define vector_flat_map_build(m) do { \
+    if (UNLIKELY(!vector_is_valid((m).keys) || !vector_is_valid((m).values))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_flat_map_build'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _fn = (m).keys.size; \
+    if (_fn < 2) break; \
+    typedef struct { TYPE_OF_VAL(*(m).keys.data) pk; size_t pi; } _fm_pair_t; \
+    _fm_pair_t *_fpairs = (_fm_pair_t *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, _fn * sizeof(_fm_pair_t)); \
+    TYPE_OF((m).values.data) _fvals = (TYPE_OF((m).values.data))private_vector_realloc( \
+        NULL_PTR, NULL_PTR, 0, _fn * sizeof(*(m).values.data)); \
+    if (UNLIKELY(_fpairs == NULL_PTR || _fvals == NULL_PTR)) { \
+        private_vector_free(NULL_PTR, _fpairs, 0); \
+        private_vector_free(NULL_PTR, _fvals, 0); \
+        private_vector_fail("[x] Error: allocation failed in 'vector_flat_map_build'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _fi = 0; _fi < _fn; _fi++) { \
+        _fpairs[_fi].pk = (m).keys.data[_fi]; \
+        _fpairs[_fi].pi = _fi; \
+    } \
+    size_t _fu; \
+    PRIVATE_VECTOR_FLAT_SORT_PAIRS(_fpairs, _fn, _fu); \
+    for (size_t _fi = 0; _fi < _fu; _fi++) { \
+        (m).keys.data[_fi] = _fpairs[_fi].pk; \
+        _fvals[_fi] = (m).values.data[_fpairs[_fi].pi]; \
+    } \
+    memcpy((m).values.data, _fvals, _fu * sizeof(*(m).values.data)); \
+    (m).keys.size   = _fu; \
+    (m).values.size = _fu; \
+    private_vector_free(NULL_PTR, _fpairs, _fn * sizeof(_fm_pair_t)); \
+    private_vector_free(NULL_PTR, _fvals, _fn * sizeof(*(m).values.data)); \
+} while(0)
+
+/**
+ * Inserts count entries from two arrays (keys_arr[i] -> values_arr[i]) in one merge pass.
+ * Keys already in the map get the new value; within the batch the last occurrence wins.
+ * O(N + B log B) instead of B separate memmoves.
+ */
+#define vector_flat_map_insert_many(m, keys_arr, values_arr, count) do { \
+    if (UNLIKELY(!vector_is_valid((m).keys) || !vector_is_valid((m).values))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_flat_map_insert_many'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _fb = (size_t)(count); \
+    if (_fb == 0) break; \
+    typedef struct { TYPE_OF_VAL(*(m).keys.data) pk; size_t pi; } _fm_pair_t; \
+    _fm_pair_t *_fpairs = (_fm_pair_t *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, _fb * sizeof(_fm_pair_t)); \
+    if (UNLIKELY(_fpairs == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_flat_map_insert_many'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _fi = 0; _fi < _fb; _fi++) { \
+        _fpairs[_fi].pk = (keys_arr)[_fi]; \
+        _fpairs[_fi].pi = _fi; \
+    } \
+    size_t _fu; \
+    PRIVATE_VECTOR_FLAT_SORT_PAIRS(_fpairs, _fb, _fu); \
+    size_t _fn = (m).keys.size; \
+    size_t _fs = _fn + _fu - PRIVATE_VECTOR_FLAT_COMMON((m).keys.data, _fn, _fpairs, _fu, PRIVATE_VECTOR_FLAT_PAIR_KEY); \
+    vector_reserve((m).keys, _fs); \
+    vector_reserve((m).values, _fs); \
+    if (UNLIKELY((m).keys.capacity < _fs || (m).values.capacity < _fs)) { \
+        private_vector_free(NULL_PTR, _fpairs, _fb * sizeof(_fm_pair_t)); \
+        break; \
+    } \
+    size_t _fr = _fn, _fj = _fu, _fw = _fs; \
+    while (_fj > 0) { \
+        _fw--; \
+        if (_fr > 0 && _fpairs[_fj - 1].pk < (m).keys.data[_fr - 1]) { \
+            _fr--; \
+            (m).keys.data[_fw]   = (m).keys.data[_fr]; \
+            (m).values.data[_fw] = (m).values.data[_fr]; \
+            continue; \
+        } \
+        if (_fr > 0 && !((m).keys.data[_fr - 1] < _fpairs[_fj - 1].pk)) _fr--;    /* same key: replace */ \
+        _fj--; \
+        (m).keys.data[_fw]   = _fpairs[_fj].pk; \
+        (m).values.data[_fw] = (values_arr)[_fpairs[_fj].pi]; \
+    } \
+    (m).keys.size   = _fs; \
+    (m).values.size = _fs; \
+    private_vector_free(NULL_PTR, _fpairs, _fb * sizeof(_fm_pair_t)); \
+} while(0)
+
+#define vector_flat_map_clear(m) do { \
+    vector_clear((m).keys); \
+    vector_clear((m).values); \
+} while(0)
+
+#define vector_flat_map_destroy(m) do { \
+    vector_destroy((m).keys); \
+    vector_destroy((m).values); \
+} while(0)
+
+/**
+ * @section Flat Set
+ * -------------------------------------------------------------------------
+ */
+#define vector_flat_set_init(s)                         vector_init((s).keys)
+#define vector_flat_set_init_with_allocator(s, alloc)   vector_init_with_allocator((s).keys, alloc)
+#define vector_flat_set_size(s)                         ((s).keys.size)
+#define vector_flat_set_empty(s)                        ((s).keys.size == 0)
+#define vector_flat_set_reserve(s, count)               vector_reserve((s).keys, count)
+#define vector_flat_set_find(s, key)                    vector_binary_search((s).keys, key)
+#define vector_flat_set_contains(s, key)                (vector_flat_set_find(s, key) >= 0)
+#define vector_flat_set_push_unsorted(s, key)           vector_push_back((s).keys, key)
+#define vector_flat_set_clear(s)                        vector_clear((s).keys)
+#define vector_flat_set_destroy(s)                      vector_destroy((s).keys)
+
+/**
+ * Inserts key if it is not present yet. O(N) memmove.
+ */
+#define vector_flat_set_insert(s, key) do { \
+    if (UNLIKELY(!vector_is_valid((s).keys))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_flat_set_insert'", __FILE__, __LINE__); \
+        break; \
+    } \
+    TYPE_OF_VAL(*(s).keys.data) _fk = (key); \
+    size_t _fp = vector_lower_bound((s).keys, _fk); \
+    if (_fp < (s).keys.size && !(_fk < (s).keys.data[_fp])) break; \
+    vector_insert((s).keys, _fp, _fk); \
+} while(0)
+
+/**
+ * Removes key if present.
+ * @return 1 if it was removed, 0 otherwise (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_flat_set_erase(s, key) ({ \
+    int _fe = 0; \
+    ptrdiff_t _fi = vector_flat_set_find(s, key); \
+    if (_fi >= 0) { \
+        vector_erase((s).keys, (size_t)_fi); \
+        _fe = 1; \
+    } \
+    _fe; \
+})
+
+/**
+ * Sorts the keys and removes duplicates (radix sort for integer and floating-point keys).
+ */
+#define vector_flat_set_build(s) do { \
+    vector_sort((s).keys); \
+    size_t _fw = 0; \
+    for (size_t _fr = 0; _fr < (s).keys.size; _fr++) \
+        if (_fw == 0 || (s).keys.data[_fw - 1] < (s).keys.data[_fr]) (s).keys.data[_fw++] = (s).keys.data[_fr]; \
+    (s).keys.size = _fw; \
+} while(0)
+
+/**
+ * Inserts count keys from an array in one merge pass. O(N + B log B).
+ */
+#define vector_flat_set_insert_many(s, keys_arr, count) do { \
+    if (UNLIKELY(!vector_is_valid((s).keys))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_flat_set_insert_many'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _fb = (size_t)(count); \
+    if (_fb == 0) break; \
+    TYPE_OF((s).keys.data) _fbatch = (TYPE_OF((s).keys.data))private_vector_realloc( \
+        NULL_PTR, NULL_PTR, 0, _fb * sizeof(*(s).keys.data)); \
+    if (UNLIKELY(_fbatch == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_flat_set_insert_many'", __FILE__, __LINE__); \
+        break; \
+    } \
+    memcpy(_fbatch, (keys_arr), _fb * sizeof(*(s).keys.data)); \
+    size_t _fu; \
+    PRIVATE_VECTOR_FLAT_SORT_KEYS(_fbatch, _fb, _fu); \
+    size_t _fn = (s).keys.size; \
+    size_t _fs = _fn + _fu - PRIVATE_VECTOR_FLAT_COMMON((s).keys.data, _fn, _fbatch, _fu, PRIVATE_VECTOR_FLAT_SELF); \
+    vector_reserve((s).keys, _fs); \
+    if (UNLIKELY((s).keys.capacity < _fs)) { \
+        private_vector_free(NULL_PTR, _fbatch, _fb * sizeof(*(s).keys.data)); \
+        break; \
+    } \
+    size_t _fr = _fn, _fj = _fu, _fw = _fs; \
+    while (_fj > 0) { \
+        _fw--; \
+        if (_fr > 0 && _fbatch[_fj - 1] < (s).keys.data[_fr - 1]) { \
+            (s).keys.data[_fw] = (s).keys.data[--_fr]; \
+            continue; \
+        } \
+        if (_fr > 0 && !((s).keys.data[_fr - 1] < _fbatch[_fj - 1])) _fr--;      /* already present */ \
+        (s).keys.data[_fw] = _fbatch[--_fj]; \
+    } \
+    (s).keys.size = _fs; \
+    private_vector_free(NULL_PTR, _fbatch, _fb * sizeof(*(s).keys.data)); \
+} while(0)
+
+#endif /* VECTOR_FLAT_MAP_H */
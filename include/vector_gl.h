@@ -0,0 +1,274 @@
+/*!
+    @file vector_gl.h header file
+    @brief  OpenGL streaming vectors: a vector whose storage is a persistently mapped buffer.
+
+    `vector_gl_stream_init` creates one buffer object with glBufferStorage and
+    maps it once with GL_MAP_PERSISTENT_BIT. The buffer is split into
+    VECTOR_GL_REGIONS regions (triple buffering by default) and the vector's
+    `.data` points at the region of the current frame, so vector_push_back and
+    vector_push_back_args write straight into GPU-visible memory: there is no
+    client-side copy and no glBufferSubData per frame.
+
+    @details
+    - One frame is: vector_gl_stream_begin (waits for the GPU to release the
+      region, empties the vector), pushes, vector_gl_stream_flush (flushes only
+      the bytes written since the last flush and returns the region's byte
+      offset for the draw call), the draw calls, then vector_gl_stream_fence.
+    - The fence placed after the draws of a region is waited on by the begin
+      that reuses that region VECTOR_GL_REGIONS frames later, so the CPU only
+      blocks when it is more than VECTOR_GL_REGIONS - 1 frames ahead.
+    - Without VECTOR_GL_COHERENT the mapping uses GL_MAP_FLUSH_EXPLICIT_BIT and
+      vector_gl_stream_flush calls glFlushMappedBufferRange on the dirty range.
+      With it the mapping is coherent and flush only returns the offset.
+    - The capacity is fixed: bytes / sizeof(element). Growing past it
+      fails like an allocation failure (VECTOR_ON_ERROR, size unchanged).
+
+    @example
+      VectorGlStream stream;
+      vector(float) vertices;
+      memset(&vertices, 0, sizeof vertices);
+      vector_gl_stream_init(vertices, &stream, GL_ARRAY_BUFFER, 1 << 20, 0);
+      while (!glfwWindowShouldClose(window)) {
+          vector_gl_stream_begin(vertices, &stream);
+          vector_push_back_args(vertices, x, y, 0.0f);               // written into the mapped buffer
+          size_t offset = vector_gl_stream_flush(vertices, &stream);
+          glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void *)offset);
+          glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vector_size(vertices) / 3));
+          vector_gl_stream_fence(&stream);
+      }
+      vector_gl_stream_destroy(vertices, &stream);
+
+    @warning
+    - Include a GL 4.4 (or ARB_buffer_storage) loader such as glad before this
+      header, and call every macro with the GL context current.
+    - Do not call vector_destroy on the vector; use vector_gl_stream_destroy.
+    - The mapping is write-only: do not read elements back (vector_sort,
+      vector_find, ...), reads from write-combined memory are very slow.
+    - Only elements above the last flush are flushed. After overwriting an
+      element below it (through `.data`), call vector_gl_stream_touch.
+*/
+
+#ifndef VECTOR_GL_H
+#define VECTOR_GL_H
+
+#include "vector.h"
+
+#ifndef GL_MAP_PERSISTENT_BIT
+    #error "vector_gl.h requires OpenGL 4.4 / ARB_buffer_storage: include your GL loader (e.g. glad) first"
+#endif
+
+/* Regions the buffer is split into; the CPU may run this many frames minus one ahead of the GPU. */
+#ifndef VECTOR_GL_REGIONS
+    #define VECTOR_GL_REGIONS 3
+#endif
+
+/* Region size is rounded up to this, so every region offset suits vertex, index and uniform bindings. */
+#ifndef VECTOR_GL_REGION_ALIGN
+    #define VECTOR_GL_REGION_ALIGN ((size_t)256)
+#endif
+
+/* vector_gl_stream_init flags */
+#define VECTOR_GL_COHERENT 1u   /* coherent mapping: no explicit flushes */
+
+typedef struct {
+    VectorAllocator allocator;
+    unsigned char  *mapped;                     /* base of the persistent mapping, NULL while unmapped */
+    size_t          region_bytes;
+    size_t          flushed;                    /* bytes of the current region already flushed */
+    GLsync          fences[VECTOR_GL_REGIONS];  /* NULL = region not in use by the GPU */
+    GLuint          buffer;
+    GLenum          target;
+    unsigned        current;                    /* region being written */
+    unsigned        flags;
+} VectorGlStream;
+
+/* !! PRIVATE !! — Do not call directly */
+static inline unsigned char *private_vector_gl_region(const VectorGlStream *gs)
+{
+    return gs->mapped + (size_t)gs->current * gs->region_bytes;
+}
+
+/* !! PRIVATE !! — Do not call directly. The region is fixed: any size that fits returns it, anything larger fails. */
+static inline void *private_vector_gl_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorGlStream *gs = (VectorGlStream *)ctx;
+    (void)ptr; (void)old_size;
+    if (UNLIKELY(gs->mapped == NULL_PTR || new_size > gs->region_bytes)) return NULL_PTR;
+    return private_vector_gl_region(gs);
+}
+
+/* !! PRIVATE !! — Do not call directly. The mapping is released by vector_gl_stream_destroy. */
+static inline void private_vector_gl_free(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx; (void)ptr; (void)size;
+}
+
+/* !! PRIVATE !! — Blocks until the GPU is done with the region, then drops its fence */
+static inline void private_vector_gl_wait(VectorGlStream *gs, unsigned region)
+{
+    GLsync fence = gs->fences[region];
+    if (fence == NULL_PTR) return;
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for (;;) {
+        GLenum rc = glClientWaitSync(fence, flags, (GLuint64)1000000000);   /* 1 s per round */
+        if (rc == GL_ALREADY_SIGNALED || rc == GL_CONDITION_SATISFIED || rc == GL_WAIT_FAILED) break;
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    gs->fences[region] = NULL_PTR;
+}
+
+/* !! PRIVATE !! — Creates and maps the buffer; returns region 0 or NULL with *err set */
+static inline void *private_vector_gl_open(VectorGlStream *gs, GLenum target, size_t region_bytes,
+                                           unsigned flags, const char **err)
+{
+    memset(gs, 0, sizeof(*gs));
+    gs->target       = target;
+    gs->flags        = flags;
+    gs->region_bytes = (region_bytes + VECTOR_GL_REGION_ALIGN - 1) & ~(VECTOR_GL_REGION_ALIGN - 1);
+    gs->allocator.realloc_fn = private_vector_gl_realloc;
+    gs->allocator.free_fn    = private_vector_gl_free;
+    gs->allocator.ctx        = gs;
+    gs->allocator.growth     = NULL_PTR;
+
+    if (gs->region_bytes == 0 || gs->region_bytes < region_bytes ||
+        gs->region_bytes > (size_t)PTRDIFF_MAX / VECTOR_GL_REGIONS) {
+        *err = "[x] Error: invalid region size in 'vector_gl_stream_init'";
+        return NULL_PTR;
+    }
+    GLsizeiptr total = (GLsizeiptr)(gs->region_bytes * VECTOR_GL_REGIONS);
+    GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                        ((flags & VECTOR_GL_COHERENT) ? GL_MAP_COHERENT_BIT : GL_MAP_FLUSH_EXPLICIT_BIT);
+    GLbitfield storage = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                         ((flags & VECTOR_GL_COHERENT) ? GL_MAP_COHERENT_BIT : 0);
+
+    glGenBuffers(1, &gs->buffer);
+    glBindBuffer(target, gs->buffer);
+    glBufferStorage(target, total, NULL_PTR, storage);
+    gs->mapped = (unsigned char *)glMapBufferRange(target, 0, total, access);
+    if (gs->mapped == NULL_PTR) {
+        glDeleteBuffers(1, &gs->buffer);
+        gs->buffer = 0;
+        *err = "[x] Error: glBufferStorage/glMapBufferRange failed in 'vector_gl_stream_init'";
+        return NULL_PTR;
+    }
+    return gs->mapped;
+}
+
+/* !! PRIVATE !! — Flushes [flushed, bytes) of the current region; returns the region's offset in the buffer */
+static inline size_t private_vector_gl_flush(VectorGlStream *gs, size_t bytes)
+{
+    size_t offset = (size_t)gs->current * gs->region_bytes;
+    if (!(gs->flags & VECTOR_GL_COHERENT) && bytes > gs->flushed) {
+        glBindBuffer(gs->target, gs->buffer);
+        glFlushMappedBufferRange(gs->target, (GLintptr)(offset + gs->flushed), (GLsizeiptr)(bytes - gs->flushed));
+    }
+    if (bytes > gs->flushed) gs->flushed = bytes;
+    return offset;
+}
+
+/* !! PRIVATE !! — Unmaps and deletes the buffer and every pending fence */
+static inline void private_vector_gl_close(VectorGlStream *gs)
+{
+    unsigned i;
+    for (i = 0; i < VECTOR_GL_REGIONS; i++) {
+        if (gs->fences[i] != NULL_PTR) glDeleteSync(gs->fences[i]);
+        gs->fences[i] = NULL_PTR;
+    }
+    if (gs->mapped != NULL_PTR) {
+        glBindBuffer(gs->target, gs->buffer);
+        glUnmapBuffer(gs->target);
+        gs->mapped = NULL_PTR;
+    }
+    if (gs->buffer != 0) glDeleteBuffers(1, &gs->buffer);
+    gs->buffer = 0;
+}
+
+/**
+ * Creates a persistently mapped buffer of VECTOR_GL_REGIONS regions and points
+ * the vector at the first one. The buffer stays bound to `target`.
+ * @param vec          An uninitialized vector of trivially copyable elements.
+ * @param gs           Pointer to a VectorGlStream that outlives the vector.
+ * @param target       Buffer binding target (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, ...).
+ * @param bytes        Bytes per region (frame), rounded up to VECTOR_GL_REGION_ALIGN. The capacity is fixed to it.
+ * @param flags        0 (explicit dirty-range flushes) or VECTOR_GL_COHERENT.
+ * @return 0 on success, -1 on failure (reported through VECTOR_ON_ERROR; vec stays uninitialized).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_gl_stream_init(vec, gs, target, bytes, flags) ({ \
+    int _rc = -1; \
+    const char *_err = NULL_PTR; \
+    VECTOR_ASSERT_TRIVIAL(vec); \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+    } else { \
+        void *_mapped = private_vector_gl_open((gs), (GLenum)(target), (size_t)(bytes), (unsigned)(flags), &_err); \
+        if (_mapped == NULL_PTR) { \
+            private_vector_fail(_err, __FILE__, __LINE__); \
+        } else { \
+            vector_init_with_allocator(vec, &(gs)->allocator); \
+            (vec).data     = (TYPE_OF((vec).data))_mapped; \
+            (vec).capacity = (gs)->region_bytes / sizeof(*(vec).data); \
+            _rc = 0; \
+        } \
+    } \
+    _rc; \
+})
+
+/**
+ * Starts a frame: waits until the GPU has finished with the next region,
+ * then points the vector at it with size 0. O(1) unless the CPU is
+ * VECTOR_GL_REGIONS frames ahead, in which case it blocks on the fence.
+ */
+#define vector_gl_stream_begin(vec, gs) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_gl_stream_begin'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_gl_wait((gs), (gs)->current); \
+    (vec).data     = (TYPE_OF((vec).data))private_vector_gl_region(gs); \
+    (vec).size     = 0; \
+    (vec).capacity = (gs)->region_bytes / sizeof(*(vec).data); \
+    (gs)->flushed  = 0; \
+} while (0)
+
+/**
+ * Makes the elements written since the last flush visible to the GPU
+ * (glFlushMappedBufferRange on that range only; nothing with VECTOR_GL_COHERENT).
+ * May be called several times per frame.
+ * @return Byte offset of the current region in the buffer (size_t): the `pointer`
+ *         of glVertexAttribPointer / `indices` of glDrawElements, or glBindBufferRange's offset.
+ */
+#define vector_gl_stream_flush(vec, gs) \
+    private_vector_gl_flush((gs), (vec).size * sizeof(*(vec).data))
+
+/**
+ * Marks elements from `index` on as dirty again, so the next flush includes
+ * them. Needed only after overwriting elements that were already flushed.
+ */
+#define vector_gl_stream_touch(vec, gs, index) do { \
+    size_t _byte = (size_t)(index) * sizeof(*(vec).data); \
+    if (_byte < (gs)->flushed) (gs)->flushed = _byte; \
+} while (0)
+
+/**
+ * Ends a frame: fences the current region after the draw calls that read it
+ * and moves on to the next region. Call after the last draw of the frame.
+ */
+#define vector_gl_stream_fence(gs) do { \
+    if ((gs)->fences[(gs)->current] != NULL_PTR) glDeleteSync((gs)->fences[(gs)->current]); \
+    (gs)->fences[(gs)->current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); \
+    (gs)->current = ((gs)->current + 1) % VECTOR_GL_REGIONS; \
+} while (0)
+
+/**
+ * Unmaps and deletes the buffer and its fences, and destroys the vector.
+ * Does not wait for the GPU; call it after the last frame has been drawn.
+ */
+#define vector_gl_stream_destroy(vec, gs) do { \
+    if (vector_is_valid(vec)) vector_destroy(vec); \
+    private_vector_gl_close(gs); \
+} while (0)
+
+#endif /* VECTOR_GL_H */
@@ -0,0 +1,177 @@
+/*!
+    @file vector_huge.h header file
+    @brief  virtual-memory backed allocator for very large vectors (POSIX).
+
+    A huge vector reserves a large range of address space up front with
+    mmap(PROT_NONE) and commits pages with mprotect as it grows, so growth
+    inside the reservation never moves or copies the buffer.
+    Shrinking decommits the tail with madvise(MADV_DONTNEED).
+
+    @details
+    - Growth past the reservation uses mremap(MREMAP_MAYMOVE) on Linux
+      (page-table move, no memcpy). Define _GNU_SOURCE before the first system
+      include to enable it; elsewhere the buffer is copied into a new mapping
+      of exactly the new size (the vector's geometric growth amortizes it).
+    - A mapping always spans max(committed bytes, reserve_bytes), so its
+      length can be recomputed from the vector's capacity on every call.
+    - Capacity grows page-granular (VECTOR_GROW_PAGE, with the policy granule
+      set to the runtime page size, so 16/64 KiB pages are honoured too), so no
+      partial pages are committed and wasted.
+
+    @example
+      VectorHugeAllocator huge;
+      vector_huge_init(&huge, (size_t)64 << 30);      // 64 GiB of address space
+      vector(uint8_t) ingest;
+      vector_init_with_allocator(ingest, vector_huge_allocator(&huge));
+
+    @warning
+    - POSIX only. Reserving address space does not consume RAM, but each vector
+      on this allocator reserves `reserve_bytes` of it.
+*/
+
+#ifndef VECTOR_HUGE_H
+#define VECTOR_HUGE_H
+
+#include "vector.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+    #define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+    #define MAP_NORESERVE 0
+#endif
+
+#ifndef VECTOR_HUGE_HAS_MREMAP
+    #if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        #define VECTOR_HUGE_HAS_MREMAP 1
+    #else
+        #define VECTOR_HUGE_HAS_MREMAP 0
+    #endif
+#endif
+
+#ifndef VECTOR_HUGE_DEFAULT_RESERVE
+    #define VECTOR_HUGE_DEFAULT_RESERVE ((size_t)1 << 34)   /* 16 GiB */
+#endif
+
+typedef struct {
+    VectorAllocator    allocator;
+    VectorGrowthPolicy growth;
+    size_t             reserve_bytes;
+    size_t             page_size;
+} VectorHugeAllocator;
+
+/* !! PRIVATE !! — Do not call directly */
+static inline size_t private_vector_huge_round(const VectorHugeAllocator *h, size_t n)
+{
+    return (n + h->page_size - 1) & ~(h->page_size - 1);
+}
+
+/* !! PRIVATE !! — Size of the mapping that backs a block with `bytes` committed; every path keeps this exact */
+static inline size_t private_vector_huge_mapping(const VectorHugeAllocator *h, size_t bytes)
+{
+    size_t committed = private_vector_huge_round(h, bytes);
+    return committed > h->reserve_bytes ? committed : h->reserve_bytes;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_huge_reserve(size_t mapping, size_t commit)
+{
+    void *base = mmap(NULL_PTR, mapping, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (UNLIKELY(base == MAP_FAILED)) return NULL_PTR;
+    if (commit != 0 && UNLIKELY(mprotect(base, commit, PROT_READ | PROT_WRITE) != 0)) {
+        munmap(base, mapping);
+        return NULL_PTR;
+    }
+    return base;
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void *private_vector_huge_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorHugeAllocator *h = (VectorHugeAllocator *)ctx;
+    size_t new_commit = private_vector_huge_round(h, new_size);
+
+    if (ptr == NULL_PTR)
+        return private_vector_huge_reserve(private_vector_huge_mapping(h, new_size), new_commit);
+
+    char  *base        = (char *)ptr;
+    size_t old_commit  = private_vector_huge_round(h, old_size);
+    size_t old_mapping = private_vector_huge_mapping(h, old_size);
+
+    if (new_commit <= old_commit) {
+        /* Decommit: give the pages back to the OS but keep the address range. */
+        if (new_commit < old_commit) {
+            madvise(base + new_commit, old_commit - new_commit, MADV_DONTNEED);
+            mprotect(base + new_commit, old_commit - new_commit, PROT_NONE);
+        }
+        size_t new_mapping = private_vector_huge_mapping(h, new_size);
+        if (new_mapping < old_mapping)
+            munmap(base + new_mapping, old_mapping - new_mapping);
+        return ptr;
+    }
+
+    if (new_commit <= old_mapping) {
+        /* Commit more of the reservation in place. */
+        if (UNLIKELY(mprotect(base + old_commit, new_commit - old_commit, PROT_READ | PROT_WRITE) != 0))
+            return NULL_PTR;
+        return ptr;
+    }
+
+#if VECTOR_HUGE_HAS_MREMAP
+    /* Past the reservation: commit it all so it is one mapping, then let the kernel move page tables. */
+    if (old_commit < old_mapping &&
+        UNLIKELY(mprotect(base + old_commit, old_mapping - old_commit, PROT_READ | PROT_WRITE) != 0))
+        return NULL_PTR;
+    void *nd = mremap(base, old_mapping, new_commit, MREMAP_MAYMOVE);
+    return nd == MAP_FAILED ? NULL_PTR : nd;
+#else
+    void *nd = private_vector_huge_reserve(private_vector_huge_mapping(h, new_size), new_commit);
+    if (UNLIKELY(nd == NULL_PTR)) return NULL_PTR;
+    memcpy(nd, ptr, old_size);
+    munmap(ptr, old_mapping);
+    return nd;
+#endif
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline void private_vector_huge_free(void *ctx, void *ptr, size_t size)
+{
+    VectorHugeAllocator *h = (VectorHugeAllocator *)ctx;
+    if (ptr != NULL_PTR) munmap(ptr, private_vector_huge_mapping(h, size));
+}
+
+/**
+ * Initializes a huge-vector allocator.
+ * @param h             Pointer to the VectorHugeAllocator to initialize.
+ * @param reserve_bytes Address space reserved per vector (0 = VECTOR_HUGE_DEFAULT_RESERVE).
+ */
+static inline void vector_huge_init(VectorHugeAllocator *h, size_t reserve_bytes)
+{
+    long ps = sysconf(_SC_PAGESIZE);
+    h->page_size = ps > 0 ? (size_t)ps : VECTOR_PAGE_SIZE;
+    h->growth.kind         = VECTOR_GROW_PAGE;
+    h->growth.min_capacity = VECTOR_GROWTH_MIN_CAPACITY;
+    h->growth.max_step     = VECTOR_GROWTH_MAX_STEP;
+    h->growth.threshold    = VECTOR_GROWTH_THRESHOLD;
+    h->growth.chunk        = VECTOR_GROWTH_CHUNK;
+    h->growth.custom       = NULL_PTR;
+    h->growth.granule      = h->page_size;     /* VECTOR_GROW_PAGE alone rounds to the compile-time VECTOR_PAGE_SIZE */
+    h->reserve_bytes = private_vector_huge_round(h, reserve_bytes ? reserve_bytes : VECTOR_HUGE_DEFAULT_RESERVE);
+    h->allocator.realloc_fn = private_vector_huge_realloc;
+    h->allocator.free_fn    = private_vector_huge_free;
+    h->allocator.ctx        = h;
+    h->allocator.growth     = &h->growth;
+}
+
+/**
+ * Returns the allocator to pass to `vector_init_with_allocator`.
+ */
+static inline const VectorAllocator *vector_huge_allocator(VectorHugeAllocator *h)
+{
+    return &h->allocator;
+}
+
+#endif /* VECTOR_HUGE_H */
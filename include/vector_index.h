@@ -0,0 +1,328 @@
+/*!
+    @file vector_index.h header file
+    @brief  open-addressing hash index over a vector for O(1) average lookups.
+
+    A VectorIndex maps element values to their positions in one vector. It is a
+    Robin Hood table (linear probing; entries that sit far from their home slot
+    displace closer ones, deletes shift the run back), storing the full 64-bit
+    hash with each element index, so rehashing never calls the user hash again.
+
+    The index lives next to the vector rather than inside it, so plain vectors
+    keep their layout. Mutate an indexed vector through the vector_index_*
+    wrappers (push_back, insert, erase, pop_back, clear), which call the regular
+    macro and then update the index incrementally. After any other mutation
+    call vector_index_rebuild.
+
+    @details
+    - hash(elem, elem_size) -> uint64_t, eq(a, b, elem_size) -> nonzero if equal.
+      NULL selects a byte-wise hash / memcmp, right for integers and for
+      structs without padding.
+    - Duplicate values are all indexed; vector_index_find returns the lowest position,
+      like vector_find.
+    - If the table cannot grow, the index is marked stale and lookups fall back to
+      a linear scan until the next successful rebuild.
+
+    @example
+      vector(uint64_t) ids;
+      VectorIndex seen;
+      vector_init(ids);
+      vector_index_build(ids, seen, NULL, NULL);
+      if (vector_index_find(ids, seen, id) < 0) vector_index_push_back(ids, seen, id);
+      vector_index_destroy(seen);
+*/
+
+#ifndef VECTOR_INDEX_H
+#define VECTOR_INDEX_H
+
+#include "vector.h"
+
+/* Maximum load, as a fraction of VECTOR_INDEX_LOAD_DEN, before the table doubles. */
+#ifndef VECTOR_INDEX_LOAD_NUM
+    #define VECTOR_INDEX_LOAD_NUM 3
+    #define VECTOR_INDEX_LOAD_DEN 4
+#endif
+
+typedef uint64_t (*VectorIndexHash)(const void *elem, size_t elem_size);
+typedef int      (*VectorIndexEq)(const void *a, const void *b, size_t elem_size);
+
+typedef struct {
+    uint64_t hash;
+    size_t   pos;       /* element index + 1; 0 marks an empty slot */
+} VectorIndexSlot;
+
+typedef struct {
+    VectorIndexSlot *slots;
+    size_t           capacity;  /* 0 or a power of two */
+    size_t           count;
+    size_t           elem_size;
+    VectorIndexHash  hash;
+    VectorIndexEq    eq;
+    int              stale;     /* table out of date: lookups scan linearly */
+} VectorIndex;
+
+/**
+ * Default hash: 8 bytes at a time multiply-xorshift, splitmix64 finalizer.
+ */
+static inline uint64_t vector_index_hash_bytes(const void *elem, size_t elem_size)
+{
+    const unsigned char *p = (const unsigned char *)elem;
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ elem_size;
+    size_t i = 0;
+    for (; i + 8 <= elem_size; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    if (i < elem_size) {
+        uint64_t w = 0;
+        memcpy(&w, p + i, elem_size - i);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+    }
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27; h *= 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+/* !! PRIVATE !! — Default equality */
+static inline int private_vector_index_eq_bytes(const void *a, const void *b, size_t elem_size)
+{
+    return memcmp(a, b, elem_size) == 0;
+}
+
+/* !! PRIVATE !! — Distance of the entry in slot i from its home slot */
+#define private_vector_index_dist(ix, i, h) (((i) - ((size_t)(h) & ((ix)->capacity - 1))) & ((ix)->capacity - 1))
+
+/* !! PRIVATE !! — Places an entry, Robin Hood style; the table has a free slot */
+static inline void private_vector_index_place(VectorIndex *ix, VectorIndexSlot cur)
+{
+    size_t mask = ix->capacity - 1, i = (size_t)cur.hash & mask, dist = 0;
+    for (;;) {
+        VectorIndexSlot *s = &ix->slots[i];
+        if (s->pos == 0) { *s = cur; return; }
+        size_t sd = private_vector_index_dist(ix, i, s->hash);
+        if (sd < dist) {
+            VectorIndexSlot t = *s; *s = cur; cur = t;
+            dist = sd;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+}
+
+/* !! PRIVATE !! — Rehashes into `capacity` slots (power of two); 0 on success */
+static inline int private_vector_index_resize(VectorIndex *ix, size_t capacity)
+{
+    if (UNLIKELY(capacity > SIZE_MAX / sizeof(VectorIndexSlot))) return -1;
+    VectorIndexSlot *ns = (VectorIndexSlot *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, capacity * sizeof(VectorIndexSlot));
+    if (UNLIKELY(ns == NULL_PTR)) return -1;
+    memset(ns, 0, capacity * sizeof(VectorIndexSlot));
+    VectorIndexSlot *old = ix->slots;
+    size_t old_cap = ix->capacity;
+    ix->slots    = ns;
+    ix->capacity = capacity;
+    for (size_t i = 0; i < old_cap; i++)
+        if (old[i].pos != 0) private_vector_index_place(ix, old[i]);
+    private_vector_free(NULL_PTR, old, old_cap * sizeof(VectorIndexSlot));
+    return 0;
+}
+
+/* !! PRIVATE !! — Makes room for `count` entries under the load limit; 0 on success */
+static inline int private_vector_index_reserve(VectorIndex *ix, size_t count)
+{
+    if (count * VECTOR_INDEX_LOAD_DEN <= ix->capacity * VECTOR_INDEX_LOAD_NUM) return 0;
+    size_t cap = ix->capacity ? ix->capacity : 16;
+    while (count * VECTOR_INDEX_LOAD_DEN > cap * VECTOR_INDEX_LOAD_NUM) {
+        if (UNLIKELY(cap > SIZE_MAX / 2)) return -1;
+        cap <<= 1;
+    }
+    return private_vector_index_resize(ix, cap);
+}
+
+/* !! PRIVATE !! — Indexes the element at `pos` */
+static inline void private_vector_index_add(VectorIndex *ix, const void *base, size_t pos)
+{
+    if (ix->stale) return;
+    if (UNLIKELY(private_vector_index_reserve(ix, ix->count + 1) != 0)) {
+        ix->stale = 1;
+        private_vector_fail("[x] Error: index allocation failed, falling back to linear search", __FILE__, __LINE__);
+        return;
+    }
+    VectorIndexSlot cur;
+    cur.hash = ix->hash((const char *)base + pos * ix->elem_size, ix->elem_size);
+    cur.pos  = pos + 1;
+    private_vector_index_place(ix, cur);
+    ix->count++;
+}
+
+/* !! PRIVATE !! — Drops the entry of the element at `pos` (still present in base), backward-shift delete */
+static inline void private_vector_index_remove(VectorIndex *ix, const void *base, size_t pos)
+{
+    if (ix->stale || ix->count == 0) return;
+    uint64_t h = ix->hash((const char *)base + pos * ix->elem_size, ix->elem_size);
+    size_t mask = ix->capacity - 1, i = (size_t)h & mask, dist = 0;
+    for (;; i = (i + 1) & mask, dist++) {
+        VectorIndexSlot *s = &ix->slots[i];
+        if (s->pos == 0 || private_vector_index_dist(ix, i, s->hash) < dist) return;    /* not indexed */
+        if (s->pos == pos + 1) break;
+    }
+    for (;;) {
+        size_t j = (i + 1) & mask;
+        VectorIndexSlot *t = &ix->slots[j];
+        if (t->pos == 0 || private_vector_index_dist(ix, j, t->hash) == 0) break;
+        ix->slots[i] = *t;
+        i = j;
+    }
+    ix->slots[i].pos = 0;
+    ix->count--;
+}
+
+/* !! PRIVATE !! — Renumbers entries at positions >= from after an insert (+1) or erase (-1) */
+static inline void private_vector_index_shift(VectorIndex *ix, size_t from, int delta)
+{
+    if (ix->stale) return;
+    for (size_t i = 0; i < ix->capacity; i++)
+        if (ix->slots[i].pos > from) ix->slots[i].pos += (size_t)(ptrdiff_t)delta;
+}
+
+/* !! PRIVATE !! — Lowest position of an element equal to *key, or -1 */
+static inline ptrdiff_t private_vector_index_find(const VectorIndex *ix, const void *base, size_t size, const void *key)
+{
+    const char *b = (const char *)base;
+    if (ix->stale) {
+        for (size_t i = 0; i < size; i++)
+            if (ix->eq(b + i * ix->elem_size, key, ix->elem_size)) return (ptrdiff_t)i;
+        return -1;
+    }
+    if (ix->count == 0) return -1;
+    uint64_t h = ix->hash(key, ix->elem_size);
+    size_t mask = ix->capacity - 1, i = (size_t)h & mask, dist = 0, best = SIZE_MAX;
+    for (;; i = (i + 1) & mask, dist++) {
+        const VectorIndexSlot *s = &ix->slots[i];
+        if (s->pos == 0 || private_vector_index_dist(ix, i, s->hash) < dist) break;
+        if (s->hash == h && s->pos - 1 < best && ix->eq(b + (s->pos - 1) * ix->elem_size, key, ix->elem_size))
+            best = s->pos - 1;
+    }
+    return best == SIZE_MAX ? -1 : (ptrdiff_t)best;
+}
+
+/* !! PRIVATE !! — Indexes base[0, size) from scratch; 0 on success (index stale otherwise) */
+static inline int private_vector_index_build(VectorIndex *ix, const void *base, size_t size)
+{
+    if (ix->slots != NULL_PTR) memset(ix->slots, 0, ix->capacity * sizeof(VectorIndexSlot));
+    ix->count = 0;
+    ix->stale = 0;
+    if (UNLIKELY(private_vector_index_reserve(ix, size) != 0)) {
+        ix->stale = 1;
+        return -1;
+    }
+    for (size_t i = 0; i < size; i++) private_vector_index_add(ix, base, i);
+    return 0;
+}
+
+/**
+ * Creates (or recreates) the index for vec in one pass.
+ * @param ix      VectorIndex to fill; zero-initialize it before the first build.
+ * @param hash_fn VectorIndexHash, or NULL for vector_index_hash_bytes.
+ * @param eq_fn   VectorIndexEq, or NULL for memcmp.
+ */
+#define vector_index_build(vec, ix, hash_fn, eq_fn) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_index_build'", __FILE__, __LINE__); \
+        break; \
+    } \
+    VectorIndexHash _ih = (hash_fn); \
+    VectorIndexEq   _ie = (eq_fn); \
+    (ix).hash      = _ih ? _ih : vector_index_hash_bytes; \
+    (ix).eq        = _ie ? _ie : private_vector_index_eq_bytes; \
+    (ix).elem_size = sizeof(*(vec).data); \
+    if (private_vector_index_build(&(ix), (vec).data, (vec).size) != 0) \
+        private_vector_fail("[x] Error: index allocation failed in 'vector_index_build'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Re-indexes vec with the hash/eq given to vector_index_build (after mutating vec directly).
+ */
+#define vector_index_rebuild(vec, ix) do { \
+    if (private_vector_index_build(&(ix), (vec).data, (vec).size) != 0) \
+        private_vector_fail("[x] Error: index allocation failed in 'vector_index_rebuild'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Position of the first element equal to value, or -1 (ptrdiff_t). O(1) on average.
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_index_find(vec, ix, value) ({ \
+    TYPE_OF_VAL(*(vec).data) _ikey = (value); \
+    private_vector_index_find(&(ix), (vec).data, (vec).size, &_ikey); \
+})
+
+/**
+ * vector_push_back that also indexes the new element.
+ */
+#define vector_index_push_back(vec, ix, value) do { \
+    size_t _in = (vec).size; \
+    vector_push_back(vec, value); \
+    if ((vec).size != _in) private_vector_index_add(&(ix), (vec).data, _in); \
+} while(0)
+
+/**
+ * vector_insert that also renumbers the shifted elements and indexes the new one. O(N).
+ */
+#define vector_index_insert(vec, ix, position, value) do { \
+    size_t _in = (vec).size; \
+    size_t _ip = (size_t)(position); \
+    vector_insert(vec, _ip, value); \
+    if ((vec).size == _in) break; \
+    private_vector_index_shift(&(ix), _ip, 1); \
+    private_vector_index_add(&(ix), (vec).data, _ip); \
+} while(0)
+
+/**
+ * vector_erase that also drops the element from the index and renumbers the tail. O(N).
+ */
+#define vector_index_erase(vec, ix, position) do { \
+    size_t _ip = (size_t)(position); \
+    if (VECTOR_CHECK(!vector_is_valid(vec) || _ip >= (vec).size)) { \
+        private_vector_fail("[x] Error: erase position out of bounds in 'vector_index_erase'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_index_remove(&(ix), (vec).data, _ip); \
+    vector_erase(vec, _ip); \
+    private_vector_index_shift(&(ix), _ip + 1, -1); \
+} while(0)
+
+/**
+ * vector_pop_back that also drops the last element from the index.
+ */
+#define vector_index_pop_back(vec, ix) do { \
+    if (VECTOR_CHECK(!vector_is_valid(vec) || (vec).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_index_pop_back' on empty/uninitialized vector", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_index_remove(&(ix), (vec).data, (vec).size - 1); \
+    vector_pop_back(vec); \
+} while(0)
+
+/**
+ * vector_clear that also empties the index (keeping its table).
+ */
+#define vector_index_clear(vec, ix) do { \
+    vector_clear(vec); \
+    if ((ix).slots != NULL_PTR) memset((ix).slots, 0, (ix).capacity * sizeof(VectorIndexSlot)); \
+    (ix).count = 0; \
+    (ix).stale = 0; \
+} while(0)
+
+/**
+ * Frees the index table. The vector is not touched.
+ */
+#define vector_index_destroy(ix) do { \
+    private_vector_free(NULL_PTR, (ix).slots, (ix).capacity * sizeof(VectorIndexSlot)); \
+    (ix).slots    = NULL_PTR; \
+    (ix).capacity = 0; \
+    (ix).count    = 0; \
+} while(0)
+
+#endif /* VECTOR_INDEX_H */
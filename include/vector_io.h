@@ -0,0 +1,484 @@
+/*!
+    @file vector_io.h header file
+    @brief  binary serialization of vectors to file descriptors and FILE streams.
+
+    A record is a 24-byte header followed by the raw elements:
+
+        magic "CVEC" | format | byte-order tag | element size | element count | elements...
+
+    Readers take the element count from the header and size the vector once
+    (one vector_append_uninit), then read straight into its tail, so loading
+    never reallocates part-way. Records can be concatenated in one stream.
+
+    @details
+    - Writers send the header and the elements with a single writev (or two
+      fwrite calls), without copying the elements into a staging buffer.
+    - `vector_writev` writes several vectors, each as its own record, in one call.
+    - VectorIoReader is a push parser for data that arrives in pieces (sockets,
+      decompressors): every `vector_io_feed` copies the bytes it is given into the
+      vector's tail and makes complete elements visible immediately.
+    - The byte-order tag tells readers whether the writer had the other
+      endianness. Such records are rejected unless VECTOR_IO_BYTESWAP is passed,
+      which swaps each element as one 2/4/8-byte scalar.
+
+    @example
+      vector_write_fd(points, fd);
+      ...
+      vector(Point) loaded;
+      vector_init(loaded);
+      if (vector_read_fd(loaded, fd, 0) != 0) ...
+
+    @warning
+    - Elements are written as raw bytes: they must not contain pointers, and the
+      reader needs the same struct layout (compiler, ABI, padding).
+    - The fd functions need POSIX (read/write/writev); the FILE* functions only stdio.
+*/
+
+#ifndef VECTOR_IO_H
+#define VECTOR_IO_H
+
+#include "vector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <errno.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #define VECTOR_IO_HAS_FD 1
+#else
+    #define VECTOR_IO_HAS_FD 0
+#endif
+
+#define VECTOR_IO_MAGIC     0x43455643u     /* "CVEC" */
+#define VECTOR_IO_FORMAT    1u
+#define VECTOR_IO_BYTE_ORDER 0x0102u        /* reads as 0x0201 on the other endianness */
+
+/* Flags for the readers */
+#define VECTOR_IO_BYTESWAP  1u              /* accept foreign-endian records and swap each element */
+
+/* Records whose data exceeds this many bytes are rejected by the readers. */
+#ifndef VECTOR_IO_MAX_BYTES
+    #define VECTOR_IO_MAX_BYTES (SIZE_MAX / 2)
+#endif
+
+/* Most bytes handed to one read or writev call (all pieces together), so the
+   result fits even a 32-bit ssize_t. */
+#ifndef VECTOR_IO_MAX_PIECE
+    #define VECTOR_IO_MAX_PIECE ((size_t)1 << 30)
+#endif
+
+/* Records gathered into one writev call by vector_writev. */
+#define VECTOR_IO_BATCH 16
+
+/**
+ * @brief Record header, in the writer's byte order.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t byte_order;
+    uint64_t elem_size;
+    uint64_t count;
+} VectorIoHeader;
+
+/**
+ * @brief One vector to write with vector_writev; build it with vector_io_slice(vec).
+ */
+typedef struct {
+    const void *data;
+    size_t      size;
+    size_t      elem_size;
+} VectorIoSlice;
+
+/* !! PRIVATE !! — vector_io_slice; a function rather than a compound literal so C++ accepts it too */
+static inline VectorIoSlice private_vector_io_slice(const void *data, size_t size, size_t elem_size)
+{
+    VectorIoSlice s;
+    s.data      = data;
+    s.size      = size;
+    s.elem_size = elem_size;
+    return s;
+}
+
+#define vector_io_slice(vec) \
+    private_vector_io_slice((const void *)(vec).data, (vec).size, sizeof(*(vec).data))
+
+/* !! PRIVATE !! — Header for `count` elements of `elem_size` bytes */
+static inline VectorIoHeader private_vector_io_header(size_t elem_size, size_t count)
+{
+    VectorIoHeader h;
+    h.magic      = VECTOR_IO_MAGIC;
+    h.format     = VECTOR_IO_FORMAT;
+    h.byte_order = VECTOR_IO_BYTE_ORDER;
+    h.elem_size  = elem_size;
+    h.count      = count;
+    return h;
+}
+
+/* !! PRIVATE !! — Byte-swaps `count` scalars of `elem_size` bytes in place */
+static inline void private_vector_io_bswap(void *data, size_t count, size_t elem_size)
+{
+    unsigned char *p = (unsigned char *)data;
+    for (size_t i = 0; i < count; i++, p += elem_size) {
+        if (elem_size == 2)      { uint16_t v; memcpy(&v, p, 2); v = __builtin_bswap16(v); memcpy(p, &v, 2); }
+        else if (elem_size == 4) { uint32_t v; memcpy(&v, p, 4); v = __builtin_bswap32(v); memcpy(p, &v, 4); }
+        else                     { uint64_t v; memcpy(&v, p, 8); v = __builtin_bswap64(v); memcpy(p, &v, 8); }
+    }
+}
+
+/* !! PRIVATE !! — Validates a received header (swapping it to host order); 0, or -1 with *err set */
+static inline int private_vector_io_check
+(
+    VectorIoHeader *h, size_t elem_size, unsigned flags,
+    int *swap, size_t *count, const char **err
+)
+{
+    *swap = 0;
+    if (h->magic == __builtin_bswap32(VECTOR_IO_MAGIC) && h->byte_order == __builtin_bswap16(VECTOR_IO_BYTE_ORDER)) {
+        h->magic      = __builtin_bswap32(h->magic);
+        h->format     = __builtin_bswap16(h->format);
+        h->byte_order = __builtin_bswap16(h->byte_order);
+        h->elem_size  = __builtin_bswap64(h->elem_size);
+        h->count      = __builtin_bswap64(h->count);
+        *swap = 1;
+    }
+    if (h->magic != VECTOR_IO_MAGIC || h->byte_order != VECTOR_IO_BYTE_ORDER) {
+        *err = "[x] Error: not a vector record (bad magic)";
+        return -1;
+    }
+    if (h->format != VECTOR_IO_FORMAT) { *err = "[x] Error: unsupported vector record format"; return -1; }
+    if (h->elem_size != elem_size)     { *err = "[x] Error: element size mismatch in vector record"; return -1; }
+    if (*swap && (!(flags & VECTOR_IO_BYTESWAP) || (elem_size != 2 && elem_size != 4 && elem_size != 8))) {
+        *err = "[x] Error: foreign byte order (pass VECTOR_IO_BYTESWAP for 2/4/8-byte scalars)";
+        return -1;
+    }
+    if (h->count > VECTOR_IO_MAX_BYTES / elem_size) { *err = "[x] Error: vector record too large"; return -1; }
+    *count = (size_t)h->count;
+    return 0;
+}
+
+#if VECTOR_IO_HAS_FD
+
+/* !! PRIVATE !! — writev until every iovec is written; returns 0 on success */
+static inline int private_vector_io_writev_all(int fd, struct iovec *iov, int n)
+{
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        size_t left = (size_t)w;
+        while (n > 0 && left >= iov->iov_len) { left -= iov->iov_len; iov++; n--; }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+    return 0;
+}
+
+/* !! PRIVATE !! — Reads up to n bytes, stopping early only at end of file; returns bytes read or -1 */
+static inline ptrdiff_t private_vector_io_read_all(int fd, void *buf, size_t n)
+{
+    size_t got = 0;
+    while (got < n) {
+        size_t want = n - got < VECTOR_IO_MAX_PIECE ? n - got : VECTOR_IO_MAX_PIECE;
+        ssize_t r = read(fd, (char *)buf + got, want);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (r == 0) break;
+        got += (size_t)r;
+    }
+    return (ptrdiff_t)got;
+}
+
+/**
+ * Writes each slice as one record (header + elements) with as few writev calls as possible.
+ * @param fd     Destination file descriptor.
+ * @param slices Vectors to write, e.g. { vector_io_slice(a), vector_io_slice(b) }.
+ * @param count  Number of slices.
+ * @return 0 on success, -1 on a write error (errno set).
+ */
+static inline int vector_writev(int fd, const VectorIoSlice *slices, size_t count)
+{
+    VectorIoHeader headers[VECTOR_IO_BATCH];
+    struct iovec   iov[VECTOR_IO_BATCH * 4];
+    int            n = 0;
+    size_t         h = 0;
+    size_t         total = 0;   /* bytes in iov, at most VECTOR_IO_MAX_PIECE */
+    const int      cap = (int)(sizeof(iov) / sizeof(iov[0]));
+
+    for (size_t i = 0; i < count; i++) {
+        if (h == VECTOR_IO_BATCH || n + 2 > cap || total > VECTOR_IO_MAX_PIECE - sizeof(VectorIoHeader)) {
+            if (private_vector_io_writev_all(fd, iov, n) != 0) return -1;
+            n = 0;
+            h = 0;
+            total = 0;
+        }
+        headers[h] = private_vector_io_header(slices[i].elem_size, slices[i].size);
+        iov[n].iov_base = &headers[h++];
+        iov[n].iov_len  = sizeof(VectorIoHeader);
+        n++;
+        total += sizeof(VectorIoHeader);
+        const char *p     = (const char *)slices[i].data;
+        size_t      bytes = slices[i].size * slices[i].elem_size;
+        while (bytes != 0) {
+            if (n == cap || total == VECTOR_IO_MAX_PIECE) {
+                if (private_vector_io_writev_all(fd, iov, n) != 0) return -1;
+                n = 0;
+                h = 0;
+                total = 0;
+            }
+            size_t room  = VECTOR_IO_MAX_PIECE - total;
+            size_t piece = bytes < room ? bytes : room;
+            iov[n].iov_base = (void *)p;
+            iov[n].iov_len  = piece;
+            n++;
+            total += piece;
+            p     += piece;
+            bytes -= piece;
+        }
+    }
+    return private_vector_io_writev_all(fd, iov, n);
+}
+
+/**
+ * Writes the vector as one record (header + elements, one writev).
+ * @return 0 on success, -1 on failure (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_write_fd(vec, fd) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_write_fd'", __FILE__, __LINE__); \
+    } else { \
+        VectorIoSlice _slice = vector_io_slice(vec); \
+        if ((_rc = vector_writev((fd), &_slice, 1)) != 0) \
+            private_vector_fail("[x] Error: write failed in 'vector_write_fd'", __FILE__, __LINE__); \
+    } \
+    _rc; \
+})
+
+/**
+ * Reads one record and appends its elements to the vector (clear it first to replace).
+ * The vector grows once, to the size announced by the header, and is read into directly.
+ * @param flags 0 or VECTOR_IO_BYTESWAP.
+ * @return 0 on success, 1 at a clean end of stream (no bytes left), -1 on failure
+ *         (the vector keeps its previous contents).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_read_fd(vec, fd, flags) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_read_fd'", __FILE__, __LINE__); \
+    } else { \
+        VectorIoHeader _hdr; \
+        const char *_err = "[x] Error: truncated header in 'vector_read_fd'"; \
+        int _swap = 0; \
+        size_t _cnt = 0; \
+        ptrdiff_t _got = private_vector_io_read_all((fd), &_hdr, sizeof(_hdr)); \
+        if (_got == 0) { \
+            _rc = 1; \
+        } else if (_got != (ptrdiff_t)sizeof(_hdr) || \
+                   private_vector_io_check(&_hdr, sizeof(*(vec).data), (unsigned)(flags), &_swap, &_cnt, &_err) != 0) { \
+            private_vector_fail(_err, __FILE__, __LINE__); \
+        } else if (_cnt == 0) { \
+            _rc = 0; \
+        } else { \
+            size_t _old = (vec).size; \
+            TYPE_OF((vec).data) _tail = vector_append_uninit(vec, _cnt); \
+            if (_tail != NULL_PTR) { \
+                size_t _bytes = _cnt * sizeof(*(vec).data); \
+                if (private_vector_io_read_all((fd), (void *)_tail, _bytes) != (ptrdiff_t)_bytes) { \
+                    (vec).size = _old; \
+                    private_vector_fail("[x] Error: truncated data in 'vector_read_fd'", __FILE__, __LINE__); \
+                } else { \
+                    if (_swap) private_vector_io_bswap((void *)_tail, _cnt, sizeof(*(vec).data)); \
+                    _rc = 0; \
+                } \
+            } \
+        } \
+    } \
+    _rc; \
+})
+
+#endif /* VECTOR_IO_HAS_FD */
+
+/**
+ * Writes the vector as one record to a stdio stream (header + elements, two fwrite calls).
+ * @return 0 on success, -1 on failure (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_write_file(vec, stream) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_write_file'", __FILE__, __LINE__); \
+    } else { \
+        VectorIoHeader _hdr = private_vector_io_header(sizeof(*(vec).data), (vec).size); \
+        if (CLIB_PREFIX fwrite(&_hdr, sizeof(_hdr), 1, (stream)) == 1 && \
+            ((vec).size == 0 || \
+             CLIB_PREFIX fwrite((vec).data, sizeof(*(vec).data), (vec).size, (stream)) == (vec).size)) \
+            _rc = 0; \
+        else \
+            private_vector_fail("[x] Error: write failed in 'vector_write_file'", __FILE__, __LINE__); \
+    } \
+    _rc; \
+})
+
+/**
+ * Reads one record from a stdio stream and appends it; same contract as vector_read_fd.
+ * @return 0 on success, 1 at a clean end of stream, -1 on failure (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_read_file(vec, stream, flags) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_read_file'", __FILE__, __LINE__); \
+    } else { \
+        VectorIoHeader _hdr; \
+        const char *_err = "[x] Error: truncated header in 'vector_read_file'"; \
+        int _swap = 0; \
+        size_t _cnt = 0; \
+        size_t _got = CLIB_PREFIX fread(&_hdr, 1, sizeof(_hdr), (stream)); \
+        if (_got == 0) { \
+            _rc = 1; \
+        } else if (_got != sizeof(_hdr) || \
+                   private_vector_io_check(&_hdr, sizeof(*(vec).data), (unsigned)(flags), &_swap, &_cnt, &_err) != 0) { \
+            private_vector_fail(_err, __FILE__, __LINE__); \
+        } else if (_cnt == 0) { \
+            _rc = 0; \
+        } else { \
+            size_t _old = (vec).size; \
+            TYPE_OF((vec).data) _tail = vector_append_uninit(vec, _cnt); \
+            if (_tail != NULL_PTR) { \
+                if (CLIB_PREFIX fread((void *)_tail, sizeof(*(vec).data), _cnt, (stream)) != _cnt) { \
+                    (vec).size = _old; \
+                    private_vector_fail("[x] Error: truncated data in 'vector_read_file'", __FILE__, __LINE__); \
+                } else { \
+                    if (_swap) private_vector_io_bswap((void *)_tail, _cnt, sizeof(*(vec).data)); \
+                    _rc = 0; \
+                } \
+            } \
+        } \
+    } \
+    _rc; \
+})
+
+/**
+ * @section Streaming Reader
+ * -------------------------------------------------------------------------
+ * Push parser for one record arriving in arbitrary pieces. Once the header is
+ * complete the vector is reserved for the whole record; later pieces are copied
+ * straight into its tail and each complete element is appended at once.
+ *
+ * @example
+ *   VectorIoReader rd;
+ *   vector_io_reader_init(&rd, 0);
+ *   while (!vector_io_reader_done(&rd) && (n = recv(sock, buf, sizeof buf, 0)) > 0)
+ *       if (vector_io_feed(samples, &rd, buf, (size_t)n) < 0) break;
+ */
+typedef struct {
+    VectorIoHeader header;
+    size_t         header_bytes;    /* header bytes received */
+    size_t         remaining;       /* element bytes still expected */
+    size_t         partial;         /* bytes of the next element already in the tail */
+    unsigned       flags;
+    int            swap;
+    int            state;           /* 0 header, 1 elements, 2 done, -1 failed */
+} VectorIoReader;
+
+static inline void vector_io_reader_init(VectorIoReader *r, unsigned flags)
+{
+    memset(r, 0, sizeof(*r));
+    r->flags = flags;
+}
+
+/* Nonzero once a whole record has been fed. */
+#define vector_io_reader_done(r) ((r)->state == 2)
+
+/* !! PRIVATE !! — Consumes header bytes; returns bytes used, -1 with *err set on a bad header */
+static inline ptrdiff_t private_vector_io_feed_header
+(
+    VectorIoReader *r, const void *buf, size_t len,
+    size_t elem_size, const char **err
+)
+{
+    size_t take = sizeof(VectorIoHeader) - r->header_bytes;
+    if (take > len) take = len;
+    memcpy((char *)&r->header + r->header_bytes, buf, take);
+    r->header_bytes += take;
+    if (r->header_bytes == sizeof(VectorIoHeader)) {
+        size_t count = 0;
+        if (private_vector_io_check(&r->header, elem_size, r->flags, &r->swap, &count, err) != 0) {
+            r->state = -1;
+            return -1;
+        }
+        r->remaining = count * elem_size;
+        r->state     = count == 0 ? 2 : 1;
+    }
+    return (ptrdiff_t)take;
+}
+
+/* !! PRIVATE !! — Copies element bytes into the tail; returns the number of elements completed */
+static inline size_t private_vector_io_feed_data
+(
+    VectorIoReader *r, void *tail,
+    const void *buf, size_t len, size_t elem_size
+)
+{
+    if (len > r->remaining) len = r->remaining;
+    memcpy((char *)tail + r->partial, buf, len);
+    size_t done = (r->partial + len) / elem_size;
+    r->partial = (r->partial + len) % elem_size;
+    r->remaining -= len;
+    if (r->swap) private_vector_io_bswap(tail, done, elem_size);
+    if (r->remaining == 0) r->state = 2;
+    return done;
+}
+
+/**
+ * Feeds the next `len` bytes of a record to the reader and appends the elements they complete.
+ * @return Bytes consumed (less than len only once the record is complete, so the rest
+ *         belongs to whatever follows it), or -1 on a bad header / allocation failure (ptrdiff_t).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_io_feed(vec, r, buf, len) ({ \
+    ptrdiff_t _used = -1; \
+    VectorIoReader *_rd = (r); \
+    const char *_in = (const char *)(buf); \
+    size_t _len = (size_t)(len); \
+    const char *_err = NULL_PTR; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_io_feed'", __FILE__, __LINE__); \
+    } else if (_rd->state >= 0) { \
+        _used = 0; \
+        if (_rd->state == 0) { \
+            _used = private_vector_io_feed_header(_rd, _in, _len, sizeof(*(vec).data), &_err); \
+            if (_used < 0) { \
+                private_vector_fail(_err, __FILE__, __LINE__); \
+            } else if (_rd->state == 1) { \
+                vector_reserve(vec, (vec).size + _rd->remaining / sizeof(*(vec).data)); \
+                if ((vec).capacity < (vec).size + _rd->remaining / sizeof(*(vec).data)) { \
+                    _rd->state = -1; \
+                    _used = -1; \
+                } \
+            } \
+        } \
+        if (_used >= 0 && _rd->state == 1 && (size_t)_used < _len) { \
+            size_t _pre = _rd->remaining; \
+            (vec).size += private_vector_io_feed_data(_rd, (void *)((vec).data + (vec).size), \
+                                                      _in + _used, _len - (size_t)_used, sizeof(*(vec).data)); \
+            _used += (ptrdiff_t)(_pre - _rd->remaining); \
+        } \
+    } \
+    _used; \
+})
+
+#endif /* VECTOR_IO_H */
@@ -0,0 +1,354 @@
+/*!
+    @file vector_mmap.h header file
+    @brief  file-backed persistent vectors (POSIX mmap).
+
+    `vector_mmap_open` maps a file straight into a vector's `.data`, so a table
+    built by one run is usable by the next one without parsing or re-pushing:
+    opening costs one mmap plus a header check, whatever the file size.
+    The file starts with a small header (format, element size, element count,
+    caller version, checksums) followed by the elements.
+
+    @details
+    - Growth goes through a VectorAllocator: the file is extended with ftruncate
+      inside an address-space reservation, so growth does not move `.data` until
+      the reservation is exhausted. Past it the mapping is remapped
+      (mremap(MREMAP_MAYMOVE) on Linux with _GNU_SOURCE, munmap + mmap elsewhere);
+      the elements live in the file, so nothing is copied either way.
+    - The element count in the header is only written by `vector_mmap_sync`
+      (and `vector_mmap_close`). After a crash the file reopens with the count of
+      the last sync; elements pushed after it are dropped.
+    - With VECTOR_MMAP_CHECKSUM, sync records a checksum of the elements and open
+      verifies it. This reads the whole file, so it is off by default.
+
+    @example
+      VectorMmapFile table_file;
+      vector(Entry) table;
+      memset(&table, 0, sizeof table);
+      if (vector_mmap_open(table, &table_file, "table.bin", TABLE_SCHEMA, 0) != 0) exit(1);
+      if (vector_empty(table)) build_table(&table);      // first run only
+      ...
+      vector_mmap_close(table, &table_file);
+
+    @warning
+    - POSIX only. Elements must be trivially copyable and contain no pointers;
+      the file is read back with the same layout (same compiler, ABI, endianness).
+    - The VectorMmapFile must outlive the vector. Do not call vector_destroy on
+      the vector directly; vector_mmap_close persists the count first.
+    - One process may open a file for writing at a time; there is no locking.
+*/
+
+#ifndef VECTOR_MMAP_H
+#define VECTOR_MMAP_H
+
+#include "vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef O_CLOEXEC
+    #define O_CLOEXEC 0
+#endif
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    #define VECTOR_MMAP_HAS_MREMAP 1
+#else
+    #define VECTOR_MMAP_HAS_MREMAP 0
+#endif
+
+/* Address space reserved for the mapping up front; growth inside it never remaps. */
+#ifndef VECTOR_MMAP_DEFAULT_RESERVE
+    #define VECTOR_MMAP_DEFAULT_RESERVE ((size_t)1 << 30)   /* 1 GiB */
+#endif
+
+#define VECTOR_MMAP_MAGIC   0x50414d4d43455643ull           /* "CVECMMAP" */
+#define VECTOR_MMAP_FORMAT  1u
+
+/* vector_mmap_open flags */
+#define VECTOR_MMAP_CHECKSUM  1u    /* record a data checksum on sync, verify it on open */
+#define VECTOR_MMAP_RESET     2u    /* discard the file's contents instead of failing on a mismatch */
+
+/**
+ * @brief On-disk header at offset 0. Elements start at `header_size`.
+ */
+typedef struct {
+    uint64_t magic;
+    uint32_t format;            /* VECTOR_MMAP_FORMAT */
+    uint32_t header_size;       /* bytes before the first element (one page) */
+    uint64_t elem_size;
+    uint64_t count;             /* elements as of the last sync */
+    uint64_t version;           /* caller's schema version */
+    uint64_t data_checksum;     /* of the first `count` elements, 0 = not recorded */
+    uint64_t header_checksum;   /* of every field above */
+} VectorMmapHeader;
+
+typedef struct {
+    VectorAllocator    allocator;
+    VectorGrowthPolicy growth;
+    VectorMmapHeader  *header;          /* start of the mapping, NULL while unmapped */
+    size_t             mapped;          /* bytes of address space mapped */
+    size_t             header_size;
+    size_t             page_size;
+    size_t             reserve_bytes;
+    unsigned           flags;
+    int                fd;
+} VectorMmapFile;
+
+/* !! PRIVATE !! — 64-bit FNV-style hash, 8 bytes per step (corruption check, not cryptographic) */
+static inline uint64_t private_vector_mmap_hash(const void *p, size_t n, uint64_t h)
+{
+    const unsigned char *s = (const unsigned char *)p;
+    for (; n >= 8; n -= 8, s += 8) {
+        uint64_t w;
+        memcpy(&w, s, 8);
+        h = (h ^ w) * 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    for (; n != 0; n--, s++) h = (h ^ *s) * 0x100000001b3ull;
+    return h;
+}
+
+/* !! PRIVATE !! — Checksum of the header fields before header_checksum */
+static inline uint64_t private_vector_mmap_header_sum(const VectorMmapHeader *hd)
+{
+    return private_vector_mmap_hash(hd, offsetof(VectorMmapHeader, header_checksum), 0xcbf29ce484222325ull);
+}
+
+/* !! PRIVATE !! — Do not call directly */
+static inline size_t private_vector_mmap_round(const VectorMmapFile *mf, size_t n)
+{
+    return (n + mf->page_size - 1) & ~(mf->page_size - 1);
+}
+
+/* !! PRIVATE !! — Maps (or remaps) at least `need` bytes of the file; returns 0 on success */
+static inline int private_vector_mmap_map(VectorMmapFile *mf, size_t need)
+{
+    if (mf->header != NULL_PTR && need <= mf->mapped) return 0;
+    size_t len = mf->mapped << 1;
+    if (len < mf->reserve_bytes) len = mf->reserve_bytes;
+    if (len < need) len = need;
+    len = private_vector_mmap_round(mf, len);
+
+    void *base;
+#if VECTOR_MMAP_HAS_MREMAP
+    if (mf->header != NULL_PTR)
+        base = mremap(mf->header, mf->mapped, len, MREMAP_MAYMOVE);
+    else
+#endif
+    {
+        if (mf->header != NULL_PTR) munmap(mf->header, mf->mapped);
+        mf->header = NULL_PTR;
+        base = mmap(NULL_PTR, len, PROT_READ | PROT_WRITE, MAP_SHARED, mf->fd, 0);
+    }
+    if (UNLIKELY(base == MAP_FAILED)) return -1;
+    mf->header = (VectorMmapHeader *)base;
+    mf->mapped = len;
+    return 0;
+}
+
+/* !! PRIVATE !! — Do not call directly. Resizes the file; the elements never move by copy. */
+static inline void *private_vector_mmap_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    VectorMmapFile *mf = (VectorMmapFile *)ctx;
+    (void)ptr; (void)old_size;
+    size_t file_len = mf->header_size + private_vector_mmap_round(mf, new_size);
+    if (UNLIKELY(file_len < new_size)) return NULL_PTR;
+    if (UNLIKELY(ftruncate(mf->fd, (off_t)file_len) != 0)) return NULL_PTR;
+    if (UNLIKELY(private_vector_mmap_map(mf, file_len) != 0)) return NULL_PTR;
+    return (char *)mf->header + mf->header_size;
+}
+
+/* !! PRIVATE !! — Do not call directly. Unmaps; the file and its length are kept. */
+static inline void private_vector_mmap_free(void *ctx, void *ptr, size_t size)
+{
+    VectorMmapFile *mf = (VectorMmapFile *)ctx;
+    (void)ptr; (void)size;
+    if (mf->header != NULL_PTR) munmap(mf->header, mf->mapped);
+    mf->header = NULL_PTR;
+    mf->mapped = 0;
+}
+
+/* !! PRIVATE !! — Writes a fresh header for an empty file */
+static inline void private_vector_mmap_format(VectorMmapFile *mf, size_t elem_size, uint64_t version)
+{
+    VectorMmapHeader *hd = mf->header;
+    memset(hd, 0, mf->header_size);
+    hd->magic       = VECTOR_MMAP_MAGIC;
+    hd->format      = VECTOR_MMAP_FORMAT;
+    hd->header_size = (uint32_t)mf->header_size;
+    hd->elem_size   = elem_size;
+    hd->count       = 0;
+    hd->version     = version;
+    hd->header_checksum = private_vector_mmap_header_sum(hd);
+}
+
+/* !! PRIVATE !! — Opens and maps `path`; returns the element pointer or NULL with *err set */
+static inline void *private_vector_mmap_open
+(
+    VectorMmapFile *mf, const char *path,
+    size_t elem_size, uint64_t version, unsigned flags,
+    size_t *count, size_t *capacity, const char **err
+)
+{
+    long ps = sysconf(_SC_PAGESIZE);
+    mf->page_size     = ps > 0 ? (size_t)ps : VECTOR_PAGE_SIZE;
+    mf->header        = NULL_PTR;
+    mf->mapped        = 0;
+    mf->header_size   = mf->page_size;
+    mf->reserve_bytes = VECTOR_MMAP_DEFAULT_RESERVE;
+    mf->flags         = flags;
+    mf->growth.kind         = VECTOR_GROW_PAGE;
+    mf->growth.min_capacity = VECTOR_GROWTH_MIN_CAPACITY;
+    mf->growth.max_step     = VECTOR_GROWTH_MAX_STEP;
+    mf->growth.threshold    = VECTOR_GROWTH_THRESHOLD;
+    mf->growth.chunk        = VECTOR_GROWTH_CHUNK;
+    mf->growth.custom       = NULL_PTR;
+    mf->growth.granule      = 0;
+    mf->allocator.realloc_fn = private_vector_mmap_realloc;
+    mf->allocator.free_fn    = private_vector_mmap_free;
+    mf->allocator.ctx        = mf;
+    mf->allocator.growth     = &mf->growth;
+
+    struct stat             st;
+    size_t                  file_len;
+    const VectorMmapHeader *hd = NULL_PTR;
+
+    mf->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mf->fd < 0) { *err = "[x] Error: cannot open file in 'vector_mmap_open'"; return NULL_PTR; }
+
+    if (fstat(mf->fd, &st) != 0) { *err = "[x] Error: cannot stat file in 'vector_mmap_open'"; goto fail; }
+    file_len = (size_t)st.st_size;
+
+    if (file_len >= sizeof(VectorMmapHeader)) {
+        if (private_vector_mmap_map(mf, file_len) != 0) { *err = "[x] Error: mmap failed in 'vector_mmap_open'"; goto fail; }
+        const char *bad = NULL_PTR;
+        hd = mf->header;
+        if (hd->magic != VECTOR_MMAP_MAGIC || hd->format != VECTOR_MMAP_FORMAT ||
+            hd->header_checksum != private_vector_mmap_header_sum(hd) ||
+            hd->header_size < sizeof(VectorMmapHeader) || hd->header_size % 64 != 0 || hd->header_size > file_len)
+            bad = "[x] Error: not a vector file (bad header) in 'vector_mmap_open'";
+        else if (hd->elem_size != elem_size)
+            bad = "[x] Error: element size mismatch in 'vector_mmap_open'";
+        else if (hd->version != version)
+            bad = "[x] Error: version mismatch in 'vector_mmap_open'";
+        else if (hd->count > (file_len - hd->header_size) / elem_size)
+            bad = "[x] Error: file truncated in 'vector_mmap_open'";
+        else if ((flags & VECTOR_MMAP_CHECKSUM) && hd->data_checksum != 0 &&
+                 hd->data_checksum != private_vector_mmap_hash((const char *)hd + hd->header_size,
+                                                               (size_t)hd->count * elem_size, 0xcbf29ce484222325ull))
+            bad = "[x] Error: data checksum mismatch in 'vector_mmap_open'";
+        if (bad != NULL_PTR) {
+            if (!(flags & VECTOR_MMAP_RESET)) { *err = bad; goto fail; }
+            hd = NULL_PTR;
+        }
+    } else if (file_len != 0 && !(flags & VECTOR_MMAP_RESET)) {
+        *err = "[x] Error: not a vector file (too short) in 'vector_mmap_open'";
+        goto fail;
+    }
+
+    if (hd == NULL_PTR) {
+        /* New or reset file: one header page, no elements. */
+        file_len = mf->header_size;
+        if (ftruncate(mf->fd, (off_t)file_len) != 0 || private_vector_mmap_map(mf, file_len) != 0) {
+            *err = "[x] Error: cannot initialize file in 'vector_mmap_open'";
+            goto fail;
+        }
+        private_vector_mmap_format(mf, elem_size, version);
+        hd = mf->header;
+    }
+    mf->header_size = hd->header_size;
+    *count    = (size_t)hd->count;
+    *capacity = (file_len - mf->header_size) / elem_size;
+    return (char *)mf->header + mf->header_size;
+
+fail:
+    private_vector_mmap_free(mf, NULL_PTR, 0);
+    close(mf->fd);
+    mf->fd = -1;
+    return NULL_PTR;
+}
+
+/* !! PRIVATE !! — Flushes the elements, then the header with the new count; returns 0 on success */
+static inline int private_vector_mmap_sync(VectorMmapFile *mf, const void *data, size_t count, size_t elem_size)
+{
+    if (UNLIKELY(private_vector_mmap_map(mf, mf->header_size) != 0)) return -1;
+    VectorMmapHeader *hd = mf->header;
+    size_t bytes = count * elem_size;
+    if (count != 0 && msync(mf->header, mf->header_size + bytes, MS_SYNC) != 0) return -1;
+    hd->count = count;
+    hd->data_checksum = 0;
+    if ((mf->flags & VECTOR_MMAP_CHECKSUM) && count != 0) {
+        hd->data_checksum = private_vector_mmap_hash(data, bytes, 0xcbf29ce484222325ull);
+        if (hd->data_checksum == 0) hd->data_checksum = 1;
+    }
+    hd->header_checksum = private_vector_mmap_header_sum(hd);
+    return msync(mf->header, mf->header_size, MS_SYNC);
+}
+
+/**
+ * Opens (creating if needed) a file-backed vector. O(1) in the file size
+ * unless VECTOR_MMAP_CHECKSUM is set.
+ * @param vec     An uninitialized vector; on success `.data` points into the mapping.
+ * @param mf      Pointer to a VectorMmapFile that outlives the vector.
+ * @param path    File path.
+ * @param version Caller schema version; a file written with another version is rejected.
+ * @param flags   0, or VECTOR_MMAP_CHECKSUM / VECTOR_MMAP_RESET.
+ * @return 0 on success, -1 on failure (reported through VECTOR_ON_ERROR; vec stays uninitialized).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_mmap_open(vec, mf, path, version, flags) ({ \
+    int _rc = -1; \
+    size_t _cnt = 0, _cap = 0; \
+    const char *_err = NULL_PTR; \
+    if (private_vector_has_magic(vec, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+    } else { \
+        void *_mapped = private_vector_mmap_open((mf), (path), sizeof(*(vec).data), (uint64_t)(version), \
+                                                 (unsigned)(flags), &_cnt, &_cap, &_err); \
+        if (_mapped == NULL_PTR) { \
+            private_vector_fail(_err, __FILE__, __LINE__); \
+        } else { \
+            vector_init_with_allocator(vec, &(mf)->allocator); \
+            (vec).data     = (TYPE_OF((vec).data))_mapped; \
+            (vec).size     = _cnt; \
+            (vec).capacity = _cap; \
+            _rc = 0; \
+        } \
+    } \
+    _rc; \
+})
+
+/**
+ * Persists the vector: flushes the elements to disk, then records the element
+ * count (and checksum) in the header.
+ * @return 0 on success, -1 on failure (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_mmap_sync(vec, mf) ({ \
+    int _rc = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_mmap_sync'", __FILE__, __LINE__); \
+    } else if ((_rc = private_vector_mmap_sync((mf), (vec).data, (vec).size, sizeof(*(vec).data))) != 0) { \
+        private_vector_fail("[x] Error: msync failed in 'vector_mmap_sync'", __FILE__, __LINE__); \
+    } \
+    _rc; \
+})
+
+/**
+ * Syncs, unmaps and closes a file-backed vector. The file keeps its contents.
+ * @return 0 on success, -1 if the final sync failed (int).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_mmap_close(vec, mf) ({ \
+    int _close_rc = vector_mmap_sync(vec, mf); \
+    if (vector_is_valid(vec)) vector_destroy(vec); \
+    if ((mf)->fd >= 0) close((mf)->fd); \
+    (mf)->fd = -1; \
+    _close_rc; \
+})
+
+#endif /* VECTOR_MMAP_H */
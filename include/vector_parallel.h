@@ -0,0 +1,503 @@
+/*!
+    @file vector_parallel.h header file
+    @brief  parallel for / transform / reduce / find over vectors on a reusable thread pool.
+
+    The element range is cut into chunks of about `grain_bytes` whose
+    boundaries fall on cache lines of the buffer being written (the vector of
+    vector_parallel_for, dst of vector_parallel_transform), so two threads
+    never write the same line.
+    Every participant (the pool's workers plus the calling thread) starts on
+    its own contiguous run of chunks and, once that is drained, steals
+    chunks from the other runs until the whole range is done.
+
+    Callbacks receive a whole chunk (a pointer to its first element and an
+    element count) rather than one element, so the per-element loop lives in
+    user code where the compiler can inline and vectorize it.
+
+    @details
+    - A NULL pool, a pool without workers, or a range below
+      VECTOR_PARALLEL_MIN_BYTES runs serially on the calling thread, with the
+      same chunking (and therefore the same reduce order).
+    - vector_parallel_reduce folds each chunk into its own partial and then
+      combines the partials in chunk order, so the operation only has to be
+      associative, not commutative.
+    - vector_parallel_find uses the SIMD scan kernels of vector_find on every
+      chunk and stops handing out chunks past the first hit.
+
+    @example
+      static void square(void *ctx, void *dst, const void *src, size_t n) {
+          const float *s = (const float *)src; float *d = (float *)dst;
+          for (size_t i = 0; i < n; i++) d[i] = s[i] * s[i];
+      }
+      VectorThreadPool pool;
+      vector_thread_pool_init(&pool, 0);                  // one thread per CPU
+      vector_parallel_transform(&pool, in, out, square, NULL);
+      ptrdiff_t at = vector_parallel_find(&pool, in, 42.0f);
+      vector_thread_pool_destroy(&pool);
+
+    @warning
+    - A pool runs one parallel call at a time; do not share it between
+      threads or call vector_parallel_* from inside a callback.
+    - Uses pthreads; with VECTOR_NO_THREADS (or without pthreads) every call
+      runs serially.
+*/
+
+#ifndef VECTOR_PARALLEL_H
+#define VECTOR_PARALLEL_H
+
+#include "vector.h"
+
+#if !defined(VECTOR_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+    #include <pthread.h>
+    #include <unistd.h>
+    #define VECTOR_PARALLEL_HAS_THREADS 1
+#else
+    #define VECTOR_PARALLEL_HAS_THREADS 0
+#endif
+
+/* Default chunk size in bytes; a pool's grain_bytes overrides it. */
+#ifndef VECTOR_PARALLEL_GRAIN_BYTES
+    #define VECTOR_PARALLEL_GRAIN_BYTES ((size_t)64 << 10)
+#endif
+
+/* Ranges smaller than this run serially on the calling thread. */
+#ifndef VECTOR_PARALLEL_MIN_BYTES
+    #define VECTOR_PARALLEL_MIN_BYTES ((size_t)256 << 10)
+#endif
+
+/** Runs fn on chunk [begin, begin + count); `chunk` points at element `begin`. */
+typedef void      (*VectorParallelForFn)(void *ctx, void *chunk, size_t begin, size_t count);
+/** Writes count results to dst from count inputs at src. */
+typedef void      (*VectorParallelTransformFn)(void *ctx, void *dst, const void *src, size_t count);
+/** Folds count elements at chunk into *acc. */
+typedef void      (*VectorParallelFoldFn)(void *ctx, void *acc, const void *chunk, size_t count);
+/** Combines the partial result at *partial into *acc. */
+typedef void      (*VectorParallelCombineFn)(void *ctx, void *acc, const void *partial);
+/** Returns the offset of the first match in the chunk, or -1. */
+typedef ptrdiff_t (*VectorParallelFindFn)(void *ctx, const void *chunk, size_t count);
+
+/* !! PRIVATE !! — Internal per-chunk callback */
+typedef void (*VectorParallelTask)(void *ctx, size_t chunk, size_t begin, size_t end);
+
+/* !! PRIVATE !! — Chunk layout of one parallel call */
+typedef struct {
+    size_t n;               /* elements */
+    size_t first_end;       /* end of chunk 0 (shortened so later chunks start on a cache line) */
+    size_t chunk;           /* elements in every later chunk */
+    size_t count;           /* number of chunks */
+    int    parallel;
+} VectorParallelPlan;
+
+/* !! PRIVATE !! — One participant's run of chunks; `next` is shared with thieves */
+typedef struct {
+    VECTOR_ALIGNAS(VECTOR_CACHE_LINE) size_t next;
+    size_t end;
+} VectorParallelCursor;
+
+typedef struct {
+    size_t                grain_bytes;  /* chunk size; 0 = VECTOR_PARALLEL_GRAIN_BYTES */
+    size_t                nthreads;     /* workers, not counting the calling thread */
+    VectorParallelCursor *cursors;      /* nthreads + 1, cache-line aligned */
+    void                 *cursor_block;
+#if VECTOR_PARALLEL_HAS_THREADS
+    pthread_t            *threads;
+    pthread_mutex_t       lock;
+    pthread_cond_t        wake;
+    pthread_cond_t        done;
+    uint64_t              generation;
+    size_t                pending;
+    size_t                started;
+    int                   stop;
+    const VectorParallelPlan *plan;
+    VectorParallelTask    task;
+    void                 *task_ctx;
+#endif
+} VectorThreadPool;
+
+/* !! PRIVATE !! — Bounds of chunk k */
+static inline size_t private_vector_parallel_begin(const VectorParallelPlan *p, size_t k)
+{
+    return k == 0 ? 0 : p->first_end + (k - 1) * p->chunk;
+}
+
+static inline size_t private_vector_parallel_end(const VectorParallelPlan *p, size_t k)
+{
+    size_t e = k == 0 ? p->first_end : p->first_end + k * p->chunk;
+    return e < p->n ? e : p->n;
+}
+
+/* !! PRIVATE !! — Splits n elements into chunks aligned to cache lines of `data`, the buffer being written */
+static inline VectorParallelPlan private_vector_parallel_plan
+(
+    const VectorThreadPool *pool, const void *data,
+    size_t n, size_t elem_size
+)
+
+{
+    VectorParallelPlan p;
+    size_t grain = (pool != NULL_PTR && pool->grain_bytes != 0) ? pool->grain_bytes : VECTOR_PARALLEL_GRAIN_BYTES;
+
+    /* Smallest element count whose byte size is a whole number of cache lines. */
+    size_t a = elem_size, b = VECTOR_CACHE_LINE;
+    while (b != 0) { size_t t = a % b; a = b; b = t; }
+    size_t line_elems = VECTOR_CACHE_LINE / a;
+
+    p.chunk = grain / elem_size;
+    p.chunk = (p.chunk + line_elems - 1) / line_elems * line_elems;
+    if (p.chunk == 0) p.chunk = line_elems;
+
+    /* Chunk 0 absorbs the misaligned head so chunk 1 onwards start on a cache line
+       (unless no element of data starts on one, e.g. a packed sub-buffer). */
+    size_t mis  = (size_t)((uintptr_t)data % VECTOR_CACHE_LINE);
+    size_t head = 0;
+    while (head < line_elems && (mis + head * elem_size) % VECTOR_CACHE_LINE != 0) head++;
+    if (head == line_elems) head = 0;
+
+    p.n         = n;
+    p.first_end = head + p.chunk < n ? head + p.chunk : n;
+    p.count     = n <= p.first_end ? 1 : 1 + (n - p.first_end + p.chunk - 1) / p.chunk;
+    p.parallel  = pool != NULL_PTR && pool->nthreads != 0 && p.count > 1 &&
+                  n * elem_size >= VECTOR_PARALLEL_MIN_BYTES;
+    return p;
+}
+
+/* !! PRIVATE !! — Drains participant `self`'s chunks, then steals from the others */
+static inline void private_vector_parallel_work
+(
+    VectorThreadPool *pool, size_t self,
+    const VectorParallelPlan *plan,
+    VectorParallelTask task, void *ctx
+)
+
+{
+    size_t parts = pool->nthreads + 1;
+    for (size_t v = 0; v < parts; v++) {
+        VectorParallelCursor *c = &pool->cursors[(self + v) % parts];
+        for (;;) {
+            size_t k = __atomic_fetch_add(&c->next, (size_t)1, __ATOMIC_RELAXED);
+            if (k >= c->end) break;
+            task(ctx, k, private_vector_parallel_begin(plan, k), private_vector_parallel_end(plan, k));
+        }
+    }
+}
+
+#if VECTOR_PARALLEL_HAS_THREADS
+/* !! PRIVATE !! — Worker thread body */
+static inline void *private_vector_thread_pool_main(void *arg)
+{
+    VectorThreadPool *pool = (VectorThreadPool *)arg;
+    uint64_t seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    size_t self = ++pool->started;
+    for (;;) {
+        while (pool->generation == seen && !pool->stop) pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->stop) break;
+        seen = pool->generation;
+        const VectorParallelPlan *plan = pool->plan;
+        VectorParallelTask task = pool->task;
+        void *ctx = pool->task_ctx;
+        pthread_mutex_unlock(&pool->lock);
+
+        private_vector_parallel_work(pool, self, plan, task, ctx);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL_PTR;
+}
+#endif
+
+/* !! PRIVATE !! — Runs task over every chunk of plan, on the pool when the plan allows it */
+static inline void private_vector_parallel_run
+(
+    VectorThreadPool *pool, const VectorParallelPlan *plan,
+    VectorParallelTask task, void *ctx
+)
+
+{
+    (void)pool;
+    if (!plan->parallel) {
+        for (size_t k = 0; k < plan->count; k++)
+            task(ctx, k, private_vector_parallel_begin(plan, k), private_vector_parallel_end(plan, k));
+        return;
+    }
+#if VECTOR_PARALLEL_HAS_THREADS
+    size_t parts = pool->nthreads + 1;
+    for (size_t p = 0; p < parts; p++) {
+        pool->cursors[p].next = plan->count * p / parts;
+        pool->cursors[p].end  = plan->count * (p + 1) / parts;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->plan     = plan;
+    pool->task     = task;
+    pool->task_ctx = ctx;
+    pool->pending  = pool->nthreads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    private_vector_parallel_work(pool, 0, plan, task, ctx);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending != 0) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+#endif
+}
+
+/**
+ * Starts a thread pool.
+ * @param pool     Pointer to the VectorThreadPool to initialize.
+ * @param nthreads Total threads including the caller (0 = one per online CPU).
+ * @note Falls back to fewer workers (down to serial) if threads cannot be created.
+ */
+static inline void vector_thread_pool_init(VectorThreadPool *pool, size_t nthreads)
+{
+    pool->grain_bytes  = 0;
+    pool->nthreads     = 0;
+    pool->cursors      = NULL_PTR;
+    pool->cursor_block = NULL_PTR;
+#if VECTOR_PARALLEL_HAS_THREADS
+    if (nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    size_t workers = nthreads - 1;
+    pool->threads    = NULL_PTR;
+    pool->generation = 0;
+    pool->pending    = 0;
+    pool->started    = 0;
+    pool->stop       = 0;
+    pthread_mutex_init(&pool->lock, NULL_PTR);
+    pthread_cond_init(&pool->wake, NULL_PTR);
+    pthread_cond_init(&pool->done, NULL_PTR);
+
+    pool->cursor_block = private_vector_realloc(NULL_PTR, NULL_PTR, 0,
+                                                nthreads * sizeof(VectorParallelCursor) + VECTOR_CACHE_LINE);
+    if (workers != 0)
+        pool->threads = (pthread_t *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, workers * sizeof(pthread_t));
+    if (UNLIKELY(pool->cursor_block == NULL_PTR || (workers != 0 && pool->threads == NULL_PTR))) workers = 0;
+    if (pool->cursor_block != NULL_PTR) {
+        uintptr_t base = ((uintptr_t)pool->cursor_block + VECTOR_CACHE_LINE - 1) & ~(uintptr_t)(VECTOR_CACHE_LINE - 1);
+        pool->cursors = (VectorParallelCursor *)base;
+    }
+    for (size_t t = 0; t < workers; t++) {
+        if (pthread_create(&pool->threads[t], NULL_PTR, private_vector_thread_pool_main, pool) != 0) break;
+        pool->nthreads++;
+    }
+#else
+    (void)nthreads;
+#endif
+}
+
+/**
+ * Stops and joins the pool's workers and frees its memory.
+ */
+static inline void vector_thread_pool_destroy(VectorThreadPool *pool)
+{
+#if VECTOR_PARALLEL_HAS_THREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t t = 0; t < pool->nthreads; t++) pthread_join(pool->threads[t], NULL_PTR);
+    private_vector_free(NULL_PTR, pool->threads, pool->nthreads * sizeof(pthread_t));
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pool->threads = NULL_PTR;
+#endif
+    private_vector_free(NULL_PTR, pool->cursor_block, (pool->nthreads + 1) * sizeof(VectorParallelCursor) + VECTOR_CACHE_LINE);
+    pool->cursor_block = NULL_PTR;
+    pool->cursors      = NULL_PTR;
+    pool->nthreads     = 0;
+}
+
+/* !! PRIVATE !! — Task state shared by the vector_parallel_* macros */
+typedef struct {
+    char                      *data;
+    char                      *out;
+    size_t                     elem_size;
+    size_t                     out_elem_size;
+    void                      *ctx;
+    VectorParallelForFn        for_fn;
+    VectorParallelTransformFn  transform_fn;
+    VectorParallelFoldFn       fold_fn;
+    char                      *partials;
+    VectorParallelFindFn       find_fn;
+    VectorFindKernel           kernel;
+    const void                *key;
+    ptrdiff_t                  found;       /* lowest match so far, PTRDIFF_MAX = none */
+} VectorParallelCall;
+
+/* !! PRIVATE !! — Chunk callbacks for each operation */
+static inline void private_vector_parallel_for_task(void *arg, size_t k, size_t begin, size_t end)
+{
+    VectorParallelCall *c = (VectorParallelCall *)arg;
+    (void)k;
+    c->for_fn(c->ctx, c->data + begin * c->elem_size, begin, end - begin);
+}
+
+static inline void private_vector_parallel_transform_task(void *arg, size_t k, size_t begin, size_t end)
+{
+    VectorParallelCall *c = (VectorParallelCall *)arg;
+    (void)k;
+    c->transform_fn(c->ctx, c->out + begin * c->out_elem_size, c->data + begin * c->elem_size, end - begin);
+}
+
+static inline void private_vector_parallel_reduce_task(void *arg, size_t k, size_t begin, size_t end)
+{
+    VectorParallelCall *c = (VectorParallelCall *)arg;
+    c->fold_fn(c->ctx, c->partials + k * c->out_elem_size, c->data + begin * c->elem_size, end - begin);
+}
+
+static inline void private_vector_parallel_find_task(void *arg, size_t k, size_t begin, size_t end)
+{
+    VectorParallelCall *c = (VectorParallelCall *)arg;
+    (void)k;
+    if ((ptrdiff_t)begin >= __atomic_load_n(&c->found, __ATOMIC_RELAXED)) return;
+    const char *chunk = c->data + begin * c->elem_size;
+    ptrdiff_t hit = c->kernel != NULL_PTR ? c->kernel(chunk, end - begin, c->key)
+                                          : c->find_fn(c->ctx, chunk, end - begin);
+    if (hit < 0) return;
+    ptrdiff_t at  = (ptrdiff_t)begin + hit;
+    ptrdiff_t cur = __atomic_load_n(&c->found, __ATOMIC_RELAXED);
+    while (at < cur && !__atomic_compare_exchange_n(&c->found, &cur, at, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+/* !! PRIVATE !! — Common call setup */
+static inline VectorParallelCall private_vector_parallel_call(const void *data, size_t elem_size, void *ctx)
+{
+    VectorParallelCall c;
+    memset(&c, 0, sizeof(c));
+    c.data      = (char *)data;
+    c.elem_size = elem_size;
+    c.ctx       = ctx;
+    c.found     = PTRDIFF_MAX;
+    return c;
+}
+
+/**
+ * Calls fn(ctx, chunk, begin, count) over every chunk of vec, in parallel.
+ * @param pool Thread pool, or NULL to run serially.
+ * @param vec  The vector to process. Elements may be modified in place.
+ * @param fn   VectorParallelForFn.
+ * @param ctx  User pointer passed to fn.
+ */
+#define vector_parallel_for(pool, vec, fn, ctx) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_parallel_for'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((vec).size == 0) break; \
+    VectorParallelCall _call = private_vector_parallel_call((vec).data, sizeof(*(vec).data), (ctx)); \
+    _call.for_fn = (fn); \
+    VectorParallelPlan _plan = private_vector_parallel_plan((pool), (vec).data, (vec).size, sizeof(*(vec).data)); \
+    private_vector_parallel_run((pool), &_plan, private_vector_parallel_for_task, &_call); \
+} while(0)
+
+/**
+ * Resizes dst to src.size and calls fn(ctx, dst_chunk, src_chunk, count) over every chunk.
+ * @param pool Thread pool, or NULL to run serially.
+ * @param src  Input vector.
+ * @param dst  Initialized output vector (any element type; may be src itself).
+ * @param fn   VectorParallelTransformFn.
+ * @param ctx  User pointer passed to fn.
+ * @note Chunks are cut on cache lines of dst; dst slots are uninitialized until fn writes them.
+ */
+#define vector_parallel_transform(pool, src, dst, fn, ctx) do { \
+    if (UNLIKELY(!vector_is_valid(src) || !vector_is_valid(dst))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_parallel_transform'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = (src).size; \
+    if ((dst).size != _n) { \
+        (void)vector_resize_uninit(dst, _n); \
+        if (UNLIKELY((dst).size != _n)) break; \
+    } \
+    if (_n == 0) break; \
+    VectorParallelCall _call = private_vector_parallel_call((src).data, sizeof(*(src).data), (ctx)); \
+    _call.out           = (char *)(dst).data; \
+    _call.out_elem_size = sizeof(*(dst).data); \
+    _call.transform_fn  = (fn); \
+    VectorParallelPlan _plan = private_vector_parallel_plan((pool), (dst).data, _n, sizeof(*(dst).data)); \
+    private_vector_parallel_run((pool), &_plan, private_vector_parallel_transform_task, &_call); \
+} while(0)
+
+/**
+ * Reduces vec into result: every chunk is folded into a copy of result's
+ * initial value, then the partials are combined into result in chunk order.
+ * @param pool    Thread pool, or NULL to run serially.
+ * @param vec     The vector to reduce.
+ * @param result  Lvalue holding the identity value on entry and the total on return.
+ * @param fold    VectorParallelFoldFn: folds a chunk into an accumulator.
+ * @param combine VectorParallelCombineFn: merges a partial into an accumulator.
+ * @param ctx     User pointer passed to fold and combine.
+ */
+#define vector_parallel_reduce(pool, vec, result, fold, combine, ctx) do { \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_parallel_reduce'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((vec).size == 0) break; \
+    VectorParallelPlan _plan = private_vector_parallel_plan((pool), (vec).data, (vec).size, sizeof(*(vec).data)); \
+    size_t _asz = sizeof(result); \
+    char  *_partials = (char *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, _plan.count * _asz); \
+    if (UNLIKELY(_partials == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_parallel_reduce'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _k = 0; _k < _plan.count; _k++) memcpy(_partials + _k * _asz, &(result), _asz); \
+    VectorParallelCall _call = private_vector_parallel_call((vec).data, sizeof(*(vec).data), (ctx)); \
+    _call.fold_fn       = (fold); \
+    _call.partials      = _partials; \
+    _call.out_elem_size = _asz; \
+    private_vector_parallel_run((pool), &_plan, private_vector_parallel_reduce_task, &_call); \
+    for (size_t _k = 0; _k < _plan.count; _k++) (combine)((ctx), &(result), _partials + _k * _asz); \
+    private_vector_free(NULL_PTR, _partials, _plan.count * _asz); \
+} while(0)
+
+/**
+ * Parallel vector_find: index of the first element equal to value, or -1.
+ * @note Integer, float and double elements scan each chunk with the SIMD kernels;
+ *       other types fall back to a serial vector_find.
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_parallel_find(pool, vec, value) ({ \
+    ptrdiff_t _found = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_parallel_find'", __FILE__, __LINE__); \
+    } else if (private_vector_scan_kernels((vec).data) == NULL_PTR) { \
+        _found = vector_find(vec, value); \
+    } else if ((vec).size != 0) { \
+        TYPE_OF_VAL(*(vec).data) _search_val = (value); \
+        VectorParallelCall _call = private_vector_parallel_call((vec).data, sizeof(*(vec).data), NULL_PTR); \
+        _call.kernel = private_vector_scan_kernels((vec).data)->find_first; \
+        _call.key    = &_search_val; \
+        VectorParallelPlan _plan = private_vector_parallel_plan((pool), (vec).data, (vec).size, sizeof(*(vec).data)); \
+        private_vector_parallel_run((pool), &_plan, private_vector_parallel_find_task, &_call); \
+        if (_call.found != PTRDIFF_MAX) _found = _call.found; \
+    } \
+    _found; \
+})
+
+/**
+ * Parallel search with a chunk predicate: index of the first match, or -1.
+ * @param pred VectorParallelFindFn returning the offset of the first match in a chunk, or -1.
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_parallel_find_if(pool, vec, pred, ctx) ({ \
+    ptrdiff_t _found = -1; \
+    if (UNLIKELY(!vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_parallel_find_if'", __FILE__, __LINE__); \
+    } else if ((vec).size != 0) { \
+        VectorParallelCall _call = private_vector_parallel_call((vec).data, sizeof(*(vec).data), (ctx)); \
+        _call.find_fn = (pred); \
+        VectorParallelPlan _plan = private_vector_parallel_plan((pool), (vec).data, (vec).size, sizeof(*(vec).data)); \
+        private_vector_parallel_run((pool), &_plan, private_vector_parallel_find_task, &_call); \
+        if (_call.found != PTRDIFF_MAX) _found = _call.found; \
+    } \
+    _found; \
+})
+
+#endif /* VECTOR_PARALLEL_H */
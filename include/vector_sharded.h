@@ -0,0 +1,250 @@
+/*!
+    @file vector_sharded.h header file
+    @brief  per-thread sharded vectors with a single-allocation merge step.
+
+    A sharded vector owns one ordinary vector per producer thread. Each shard
+    starts on its own cache line, so threads appending to neighbouring shards
+    never share a line, and every shard is used with the regular vector macros
+    (uncontended, no atomics). `vector_sharded_merge` concatenates the shards
+    into one `vector(type)` with a single reservation; large merges copy the
+    shards from several threads at once.
+
+    @example
+      vector_sharded(Hit) hits;
+      vector_sharded_init(hits, nthreads);
+      // on thread t:
+      vector_push_back(vector_sharded_shard(hits, t), h);
+      // after joining the producers:
+      vector(Hit) all;
+      vector_init(all);
+      vector_sharded_merge(hits, all);
+      vector_sharded_destroy(hits);
+
+    @warning
+    - Shard t must only be touched by one thread at a time.
+    - `vector_sharded_merge` must not race with producers.
+    - The parallel merge uses pthreads; define VECTOR_NO_THREADS (or build on
+      a platform without them) to always merge on the calling thread.
+*/
+
+#ifndef VECTOR_SHARDED_H
+#define VECTOR_SHARDED_H
+
+#include "vector.h"
+
+#if !defined(VECTOR_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+    #include <pthread.h>
+    #define VECTOR_SHARDED_HAS_THREADS 1
+#else
+    #define VECTOR_SHARDED_HAS_THREADS 0
+#endif
+
+/* Merges below this many bytes are copied on the calling thread. */
+#ifndef VECTOR_SHARDED_PARALLEL_BYTES
+    #define VECTOR_SHARDED_PARALLEL_BYTES ((size_t)4 << 20)
+#endif
+
+/* Upper bound on threads used by one merge. */
+#ifndef VECTOR_SHARDED_MERGE_THREADS
+    #define VECTOR_SHARDED_MERGE_THREADS 8
+#endif
+
+/**
+ * @brief One shard: a regular vector aligned (and therefore padded) to a cache line.
+ */
+#define VECTOR_SHARD_DEFINE(type) \
+    struct { \
+        VECTOR_ALIGNAS(VECTOR_CACHE_LINE) VECTOR_FIELDS(type) \
+    }
+
+/**
+ * @brief Declares an anonymous sharded vector struct for the given type.
+ */
+#define vector_sharded(type) \
+    struct { \
+        VECTOR_SHARD_DEFINE(type) *shards; \
+        size_t                     count; \
+        void                      *block;   /* allocation backing `shards` */ \
+        VECTOR_MAGIC_FIELD \
+    }
+
+/**
+ * Shard `index` as a vector lvalue, usable with every vector macro.
+ * @note `index` is evaluated several times by the vector macros; pass a plain variable.
+ */
+#define vector_sharded_shard(sv, index) ((sv).shards[(index)])
+
+/* !! PRIVATE !! — Shard `i` of a shard array with element stride `stride` */
+#define private_vector_sharded_at(shards, stride, i) \
+    ((const VectorBase *)((const char *)(shards) + (i) * (stride)))
+
+/* !! PRIVATE !! — Total elements over all shards */
+static inline size_t private_vector_sharded_size(const void *shards, size_t stride, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += private_vector_sharded_at(shards, stride, i)->size;
+    return total;
+}
+
+typedef struct {
+    const void   *shards;
+    size_t        stride;
+    size_t        count;
+    size_t        elem_size;
+    const size_t *offsets;      /* element offset of each shard in dst */
+    char         *dst;
+    size_t        first;        /* this job copies shards first, first + step, ... */
+    size_t        step;
+} VectorShardedJob;
+
+/* !! PRIVATE !! — Copies the shards assigned to one merge job */
+static inline void *private_vector_sharded_job(void *arg)
+{
+    const VectorShardedJob *job = (const VectorShardedJob *)arg;
+    for (size_t i = job->first; i < job->count; i += job->step) {
+        const VectorBase *s = private_vector_sharded_at(job->shards, job->stride, i);
+        if (s->size != 0)
+            memcpy(job->dst + job->offsets[i] * job->elem_size, s->data, s->size * job->elem_size);
+    }
+    return NULL_PTR;
+}
+
+/* !! PRIVATE !! — Copies every shard, in order, to dst; spreads large copies over threads */
+static inline void private_vector_sharded_copy
+(
+    void *dst, const void *shards,
+    size_t stride, size_t count,
+    size_t elem_size, size_t total
+)
+
+{
+    size_t threads = count < VECTOR_SHARDED_MERGE_THREADS ? count : VECTOR_SHARDED_MERGE_THREADS;
+    size_t *offsets = NULL_PTR;
+    if (VECTOR_SHARDED_HAS_THREADS && threads > 1 && total * elem_size >= VECTOR_SHARDED_PARALLEL_BYTES)
+        offsets = (size_t *)private_vector_realloc(NULL_PTR, NULL_PTR, 0, count * sizeof(size_t));
+
+    if (offsets == NULL_PTR) {
+        char *out = (char *)dst;
+        for (size_t i = 0; i < count; i++) {
+            const VectorBase *s = private_vector_sharded_at(shards, stride, i);
+            if (s->size != 0) memcpy(out, s->data, s->size * elem_size);
+            out += s->size * elem_size;
+        }
+        return;
+    }
+
+    for (size_t i = 0, off = 0; i < count; i++) {
+        offsets[i] = off;
+        off += private_vector_sharded_at(shards, stride, i)->size;
+    }
+    VectorShardedJob jobs[VECTOR_SHARDED_MERGE_THREADS];
+    for (size_t t = 0; t < threads; t++) {
+        jobs[t].shards    = shards;
+        jobs[t].stride    = stride;
+        jobs[t].count     = count;
+        jobs[t].elem_size = elem_size;
+        jobs[t].offsets   = offsets;
+        jobs[t].dst       = (char *)dst;
+        jobs[t].first     = t;
+        jobs[t].step      = threads;
+    }
+#if VECTOR_SHARDED_HAS_THREADS
+    pthread_t tid[VECTOR_SHARDED_MERGE_THREADS];
+    int       started[VECTOR_SHARDED_MERGE_THREADS] = { 0 };
+    for (size_t t = 1; t < threads; t++)
+        started[t] = pthread_create(&tid[t], NULL_PTR, private_vector_sharded_job, &jobs[t]) == 0;
+    private_vector_sharded_job(&jobs[0]);
+    for (size_t t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(tid[t], NULL_PTR);
+        else            private_vector_sharded_job(&jobs[t]);
+    }
+#else
+    for (size_t t = 0; t < threads; t++) private_vector_sharded_job(&jobs[t]);
+#endif
+    private_vector_free(NULL_PTR, offsets, count * sizeof(size_t));
+}
+
+/**
+ * Initializes a sharded vector with `shard_count` empty shards.
+ * @param sv          The sharded vector structure to initialize.
+ * @param shard_count Number of shards (usually one per producer thread).
+ */
+#define vector_sharded_init(sv, shard_count) do { \
+    if (private_vector_has_magic(sv, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _cnt   = (size_t)(shard_count); \
+    size_t _bytes = _cnt * sizeof(*(sv).shards); \
+    (sv).count  = 0; \
+    (sv).shards = NULL_PTR; \
+    (sv).block  = private_vector_realloc(NULL_PTR, NULL_PTR, 0, _bytes + VECTOR_CACHE_LINE); \
+    if (UNLIKELY((sv).block == NULL_PTR)) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_sharded_init'", __FILE__, __LINE__); \
+        break; \
+    } \
+    uintptr_t _base = ((uintptr_t)(sv).block + VECTOR_CACHE_LINE - 1) & ~(uintptr_t)(VECTOR_CACHE_LINE - 1); \
+    (sv).shards = (TYPE_OF((sv).shards))_base; \
+    memset((void *)(sv).shards, 0, _bytes); \
+    for (size_t _i = 0; _i < _cnt; _i++) vector_init((sv).shards[_i]); \
+    (sv).count = _cnt; \
+    private_vector_set_magic(sv, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Returns the total number of elements over all shards (macro, size_t).
+ */
+#define vector_sharded_size(sv) \
+    private_vector_sharded_size((sv).shards, sizeof(*(sv).shards), (sv).count)
+
+/**
+ * Appends the contents of every shard, shard 0 first, to a regular vector.
+ * @param sv  The sharded vector (producers must have finished). Shards are left unchanged.
+ * @param out An initialized `vector(type)` with the same element type.
+ * @note One reservation on `out`; merges above VECTOR_SHARDED_PARALLEL_BYTES copy in parallel.
+ */
+#define vector_sharded_merge(sv, out) do { \
+    VECTOR_ASSERT_SAME_TYPE(out, (sv).shards[0]); \
+    if (UNLIKELY(!vector_is_valid(sv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_sharded_merge'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _total = vector_sharded_size(sv); \
+    TYPE_OF((out).data) _dst = vector_append_uninit(out, _total); \
+    if (UNLIKELY(_dst == NULL_PTR)) break; \
+    private_vector_sharded_copy(_dst, (sv).shards, sizeof(*(sv).shards), (sv).count, \
+                                sizeof(*(out).data), _total); \
+} while(0)
+
+/**
+ * Empties every shard, keeping their memory for the next round.
+ */
+#define vector_sharded_clear(sv) do { \
+    if (UNLIKELY(!vector_is_valid(sv))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_sharded_clear'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _i = 0; _i < (sv).count; _i++) (sv).shards[_i].size = 0; \
+} while(0)
+
+/**
+ * Destroys every shard and frees the shard array.
+ */
+#define vector_sharded_destroy(sv) do { \
+    if (private_vector_has_magic(sv, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(sv))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _i = 0; _i < (sv).count; _i++) vector_destroy((sv).shards[_i]); \
+    private_vector_free(NULL_PTR, (sv).block, (sv).count * sizeof(*(sv).shards) + VECTOR_CACHE_LINE); \
+    (sv).shards = NULL_PTR; \
+    (sv).block  = NULL_PTR; \
+    (sv).count  = 0; \
+    private_vector_set_magic(sv, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+#endif /* VECTOR_SHARDED_H */
@@ -0,0 +1,452 @@
+/*!
+    @file vector_soa.h header file
+    @brief  struct-of-arrays vectors: one column per field, one allocation.
+
+    `vector_soa(type, field, ...)` stores the listed fields of `type` as separate
+    columns that share one size and capacity, so a pass that reads one field
+    streams only that column from memory. All columns live in one block
+    (each column starts on a VECTOR_SOA_COLUMN_ALIGN boundary inside it) and
+    grow together with one realloc through the usual VectorAllocator hook.
+
+    @example
+      typedef struct { float x, y, z; uint32_t id; } Particle;
+      #define PARTICLE_COLUMNS x, y, z, id
+
+      vector_soa(Particle, PARTICLE_COLUMNS) ps;
+      vector_soa_init(ps, PARTICLE_COLUMNS);
+      vector_soa_push_back(ps, ((Particle){ 1, 2, 3, 42 }));
+      vector_soa_foreach_field(ps, x, px) *px += 1.0f;     // touches only the x column
+      float y0 = vector_soa_at_field(ps, 0, y);
+      vector_soa_destroy(ps);
+
+    @details
+    - Columns are reachable as plain typed arrays: `vector_soa_field(ps, x)` or
+      `ps.col.x`, valid until the next growth.
+    - `vector_soa_init` takes the same field list as the declaration (keep it in
+      one #define as above); the order does not matter, a missing or unknown
+      field is a compile error.
+    - `vector_soa_from_vector` / `vector_soa_to_vector` convert from and to a
+      `vector(type)`, one column at a time.
+
+    @warning
+    - Up to VECTOR_SOA_MAX_FIELDS (16) columns. Fields not listed are dropped.
+    - Fields must be trivially copyable; column alignment is at most the
+      allocator's alignment (16 bytes for malloc).
+*/
+
+#ifndef VECTOR_SOA_H
+#define VECTOR_SOA_H
+
+#include "vector.h"
+
+#define VECTOR_SOA_MAX_FIELDS 16
+
+/* Each column starts on a multiple of this many bytes inside the block. */
+#ifndef VECTOR_SOA_COLUMN_ALIGN
+    #define VECTOR_SOA_COLUMN_ALIGN 64
+#endif
+
+/**
+ * @brief Where a column's values live in the row type.
+ */
+typedef struct {
+    size_t offset;      /* offsetof(type, field) */
+    size_t size;        /* sizeof(field) */
+} VectorSoaField;
+
+/* !! PRIVATE !! — Field-list expansion (up to VECTOR_SOA_MAX_FIELDS) */
+#define PRIVATE_VECTOR_SOA_NARGS(...) \
+    PRIVATE_VECTOR_SOA_NARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define PRIVATE_VECTOR_SOA_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define PRIVATE_VECTOR_SOA_CAT(a, b)  PRIVATE_VECTOR_SOA_CAT_(a, b)
+#define PRIVATE_VECTOR_SOA_CAT_(a, b) a##b
+#define PRIVATE_VECTOR_SOA_MAP(m, c, ...) \
+    PRIVATE_VECTOR_SOA_CAT(PRIVATE_VECTOR_SOA_MAP_, PRIVATE_VECTOR_SOA_NARGS(__VA_ARGS__))(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_1(m, c, a)       m(c, a)
+#define PRIVATE_VECTOR_SOA_MAP_2(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_1(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_3(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_2(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_4(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_3(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_5(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_4(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_6(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_5(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_7(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_6(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_8(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_7(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_9(m, c, a, ...)  m(c, a) PRIVATE_VECTOR_SOA_MAP_8(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_10(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_9(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_11(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_10(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_12(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_11(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_13(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_12(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_14(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_13(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_15(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_14(m, c, __VA_ARGS__)
+#define PRIVATE_VECTOR_SOA_MAP_16(m, c, a, ...) m(c, a) PRIVATE_VECTOR_SOA_MAP_15(m, c, __VA_ARGS__)
+
+/* !! PRIVATE !! — One typed column pointer */
+#define PRIVATE_VECTOR_SOA_COLUMN(type, f) TYPE_OF(((type *)0)->f) *f;
+
+/* !! PRIVATE !! — Fills the descriptor of column `f`, indexed by its position in `col` */
+#define PRIVATE_VECTOR_SOA_DESCRIBE(soa, f) \
+    (soa).fields[offsetof(TYPE_OF((soa).col), f) / sizeof(void *)].offset = offsetof(TYPE_OF_VAL(*(soa).row), f); \
+    (soa).fields[offsetof(TYPE_OF((soa).col), f) / sizeof(void *)].size   = sizeof(*(soa).col.f);
+
+/**
+ * @brief Declares an anonymous struct-of-arrays vector over the listed fields of `type`.
+ */
+#define vector_soa(type, ...) \
+    struct { \
+        struct { PRIVATE_VECTOR_SOA_MAP(PRIVATE_VECTOR_SOA_COLUMN, type, __VA_ARGS__) } col; \
+        size_t                 size; \
+        size_t                 capacity; \
+        const VectorAllocator *allocator; \
+        type                  *row;     /* never set; carries the row type */ \
+        VectorSoaField         fields[PRIVATE_VECTOR_SOA_NARGS(__VA_ARGS__)]; \
+        VECTOR_MAGIC_FIELD \
+    }
+
+/* !! PRIVATE !! — Number of columns of a vector_soa */
+#define private_vector_soa_ncols(soa) (sizeof((soa).col) / sizeof(void *))
+
+/* !! PRIVATE !! — Column pointers are read and written with memcpy (they have distinct types) */
+static inline char *private_vector_soa_col(const void *cols, size_t k)
+{
+    char *p;
+    memcpy(&p, (const char *)cols + k * sizeof(void *), sizeof(p));
+    return p;
+}
+
+static inline void private_vector_soa_set_col(void *cols, size_t k, char *p)
+{
+    memcpy((char *)cols + k * sizeof(void *), &p, sizeof(p));
+}
+
+/* !! PRIVATE !! — Bytes of one row over all columns */
+static inline size_t private_vector_soa_row_size(const VectorSoaField *f, size_t n)
+{
+    size_t s = 0;
+    for (size_t k = 0; k < n; k++) s += f[k].size;
+    return s;
+}
+
+/* !! PRIVATE !! — Column offsets for capacity `cap`; returns the block size */
+static inline size_t private_vector_soa_layout(const VectorSoaField *f, size_t n, size_t cap, size_t *offs)
+{
+    size_t at = 0;
+    for (size_t k = 0; k < n; k++) {
+        offs[k] = at;
+        at += (cap * f[k].size + VECTOR_SOA_COLUMN_ALIGN - 1) & ~(size_t)(VECTOR_SOA_COLUMN_ALIGN - 1);
+    }
+    return at;
+}
+
+/* !! PRIVATE !! — Moves every column to its place for new_cap with one realloc; 0 on success */
+static inline int private_vector_soa_realloc
+(
+    void *cols, const VectorSoaField *f, size_t n,
+    size_t size, size_t old_cap, size_t new_cap,
+    const VectorAllocator *alloc
+)
+{
+    size_t old_offs[VECTOR_SOA_MAX_FIELDS], new_offs[VECTOR_SOA_MAX_FIELDS];
+    size_t old_bytes = private_vector_soa_layout(f, n, old_cap, old_offs);
+    size_t new_bytes = private_vector_soa_layout(f, n, new_cap, new_offs);
+    char  *base      = old_cap ? private_vector_soa_col(cols, 0) : NULL_PTR;
+
+    if (new_cap == 0) {
+        private_vector_free(alloc, base, old_bytes);
+        for (size_t k = 0; k < n; k++) private_vector_soa_set_col(cols, k, NULL_PTR);
+        return 0;
+    }
+    if (new_cap < old_cap)         /* shrink: pack the columns down before the block gets smaller */
+        for (size_t k = 1; k < n; k++) memmove(base + new_offs[k], base + old_offs[k], size * f[k].size);
+
+    char *nb = (char *)private_vector_realloc(alloc, base, old_bytes, new_bytes);
+    if (UNLIKELY(nb == NULL_PTR)) {
+        if (new_cap < old_cap)      /* undo the packing; the old block is still intact */
+            for (size_t k = n; k-- > 1; ) memmove(base + old_offs[k], base + new_offs[k], size * f[k].size);
+        return -1;
+    }
+    if (new_cap > old_cap)         /* grow: spread the columns out, last one first */
+        for (size_t k = n; k-- > 1; ) memmove(nb + new_offs[k], nb + old_offs[k], size * f[k].size);
+    for (size_t k = 0; k < n; k++) private_vector_soa_set_col(cols, k, nb + new_offs[k]);
+    return 0;
+}
+
+/* !! PRIVATE !! — Grows to hold `needed` rows using the allocator's growth policy; 0 on success */
+static inline int private_vector_soa_grow
+(
+    void *cols, const VectorSoaField *f, size_t n,
+    size_t size, size_t *capacity, size_t needed,
+    const VectorAllocator *alloc, int exact
+)
+{
+    if (needed <= *capacity) return 0;
+    const VectorGrowthPolicy *p = private_vector_growth(alloc);
+    size_t row = private_vector_soa_row_size(f, n);
+    size_t nc  = exact ? private_vector_fit_capacity(p, needed, row)
+                       : private_vector_next_capacity(p, *capacity, needed, row);
+    if (private_vector_soa_realloc(cols, f, n, size, *capacity, nc, alloc) != 0) return -1;
+    *capacity = nc;
+    return 0;
+}
+
+/* !! PRIVATE !! — Copies one row struct into row `index` of every column */
+static inline void private_vector_soa_scatter(void *cols, const VectorSoaField *f, size_t n, size_t index, const void *row)
+{
+    for (size_t k = 0; k < n; k++)
+        memcpy(private_vector_soa_col(cols, k) + index * f[k].size, (const char *)row + f[k].offset, f[k].size);
+}
+
+/* !! PRIVATE !! — Copies row `index` of every column into a row struct */
+static inline void private_vector_soa_gather(const void *cols, const VectorSoaField *f, size_t n, size_t index, void *row)
+{
+    for (size_t k = 0; k < n; k++)
+        memcpy((char *)row + f[k].offset, private_vector_soa_col(cols, k) + index * f[k].size, f[k].size);
+}
+
+/* !! PRIVATE !! — Strided copy of one field: `count` items of `size` bytes, src/dst strides in bytes */
+static inline void private_vector_soa_copy_field
+(
+    char *dst, size_t dst_stride,
+    const char *src, size_t src_stride,
+    size_t size, size_t count
+)
+{
+    switch (size) {
+        case 4: for (size_t i = 0; i < count; i++) memcpy(dst + i * dst_stride, src + i * src_stride, 4); break;
+        case 8: for (size_t i = 0; i < count; i++) memcpy(dst + i * dst_stride, src + i * src_stride, 8); break;
+        case 2: for (size_t i = 0; i < count; i++) memcpy(dst + i * dst_stride, src + i * src_stride, 2); break;
+        case 1: for (size_t i = 0; i < count; i++) dst[i * dst_stride] = src[i * src_stride]; break;
+        default: for (size_t i = 0; i < count; i++) memcpy(dst + i * dst_stride, src + i * src_stride, size); break;
+    }
+}
+
+#ifdef __cplusplus
+    #define PRIVATE_VECTOR_SOA_ASSERT(soa, nfields) \
+        static_assert(std::is_trivially_copyable<TYPE_OF_VAL(*(soa).row)>::value && \
+                      sizeof((soa).fields) / sizeof((soa).fields[0]) == (nfields), \
+                      "vector_soa<T>: T must be trivially copyable and every column listed once")
+#else
+    #define PRIVATE_VECTOR_SOA_ASSERT(soa, nfields) \
+        _Static_assert(sizeof((soa).fields) / sizeof((soa).fields[0]) == (nfields), \
+                       "vector_soa_init: the field list must match the declaration")
+#endif
+
+/**
+ * Initializes a vector_soa. No memory is allocated until the first growth.
+ * @param soa The SoA vector to initialize.
+ * @param ... The same field list as in its declaration (any order).
+ */
+#define vector_soa_init(soa, ...) do { \
+    PRIVATE_VECTOR_SOA_ASSERT(soa, PRIVATE_VECTOR_SOA_NARGS(__VA_ARGS__)); \
+    if (private_vector_has_magic(soa, VECTOR_MAGIC_INIT)) { \
+        private_vector_fail("[!] Warning: vector already initialized", __FILE__, __LINE__); \
+        break; \
+    } \
+    memset((void *)&(soa).col, 0, sizeof((soa).col)); \
+    memset((void *)(soa).fields, 0, sizeof((soa).fields)); \
+    PRIVATE_VECTOR_SOA_MAP(PRIVATE_VECTOR_SOA_DESCRIBE, soa, __VA_ARGS__) \
+    (soa).size      = 0; \
+    (soa).capacity  = 0; \
+    (soa).allocator = NULL_PTR; \
+    (soa).row       = NULL_PTR; \
+    private_vector_set_magic(soa, VECTOR_MAGIC_INIT); \
+} while(0)
+
+/**
+ * Like vector_soa_init, attaching a custom allocator (and its growth policy).
+ */
+#define vector_soa_init_with_allocator(soa, alloc, ...) do { \
+    vector_soa_init(soa, __VA_ARGS__); \
+    (soa).allocator = (alloc); \
+} while(0)
+
+#define vector_soa_size(soa)        ((soa).size)
+#define vector_soa_capacity(soa)    ((soa).capacity)
+#define vector_soa_empty(soa)       ((soa).size == 0)
+
+/**
+ * @brief Column `field` as a typed array (type*), valid until the next growth.
+ */
+#define vector_soa_field(soa, field) ((soa).col.field)
+
+#ifdef VECTOR_UNCHECKED
+    #define vector_soa_at_field(soa, index, field) ((soa).col.field[(index)])
+#else
+/**
+ * @brief Bounds-checked access to `field` of row `index` (lvalue). Aborts when out of bounds.
+ */
+#define vector_soa_at_field(soa, index, field) \
+    ((vector_is_valid(soa) && (size_t)(index) < (soa).size) ? \
+     (soa).col.field[(index)] : \
+     (private_vector_fail("[x] Error: out-of-bounds access", __FILE__, __LINE__), \
+      abort(), VECTOR_UNREACHABLE(), (soa).col.field[0]))
+#endif
+
+/**
+ * Iterates over one column; `item` is a pointer to the field of each row.
+ * @warning Do NOT change the size inside this loop.
+ */
+#define vector_soa_foreach_field(soa, field, item) \
+    for (TYPE_OF_VAL(*(soa).col.field) *item = (soa).col.field; \
+         item < (soa).col.field + (soa).size; \
+         ++item)
+
+/**
+ * Reserves capacity for at least new_capacity rows in every column (one realloc).
+ */
+#define vector_soa_reserve(soa, new_capacity) do { \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_reserve'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (private_vector_soa_grow(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), (soa).size, \
+                                &(soa).capacity, (size_t)(new_capacity), (soa).allocator, 1) != 0) \
+        private_vector_fail("[x] Error: allocation failed in 'vector_soa_reserve'", __FILE__, __LINE__); \
+} while(0)
+
+/**
+ * Appends a row: each listed field of `value` goes to its column.
+ * @param value A value of the row type.
+ */
+#define vector_soa_push_back(soa, value) do { \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    TYPE_OF_VAL(*(soa).row) _row = (value); \
+    if (UNLIKELY((soa).size >= (soa).capacity) && \
+        private_vector_soa_grow(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), (soa).size, \
+                                &(soa).capacity, (soa).size + 1, (soa).allocator, 0) != 0) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_soa_push_back'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_soa_scatter(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), (soa).size++, &_row); \
+} while(0)
+
+/**
+ * Reassembles row `index` into a value of the row type (fields not listed are zero).
+ *
+ * @note Uses GNU statement expression ({...}) — GCC/Clang only.
+ */
+#define vector_soa_get(soa, index) ({ \
+    TYPE_OF_VAL(*(soa).row) _row; \
+    memset((void *)&_row, 0, sizeof(_row)); \
+    size_t _at = (size_t)(index); \
+    if (VECTOR_CHECK(!vector_is_valid(soa) || _at >= (soa).size)) { \
+        private_vector_fail("[x] Error: out-of-bounds access in 'vector_soa_get'", __FILE__, __LINE__); \
+        abort(); \
+    } \
+    private_vector_soa_gather(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), _at, &_row); \
+    _row; \
+})
+
+/**
+ * Overwrites row `index` with the listed fields of `value`.
+ */
+#define vector_soa_set(soa, index, value) do { \
+    TYPE_OF_VAL(*(soa).row) _row = (value); \
+    size_t _at = (size_t)(index); \
+    if (VECTOR_CHECK(!vector_is_valid(soa) || _at >= (soa).size)) { \
+        private_vector_fail("[x] Error: out-of-bounds access in 'vector_soa_set'", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_soa_scatter(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), _at, &_row); \
+} while(0)
+
+/**
+ * Removes the last row.
+ */
+#define vector_soa_pop_back(soa) do { \
+    if (VECTOR_CHECK(!vector_is_valid(soa) || (soa).size == 0)) { \
+        private_vector_fail("[x] Error: 'vector_soa_pop_back' on empty/uninitialized vector", __FILE__, __LINE__); \
+        break; \
+    } \
+    (soa).size--; \
+} while(0)
+
+/**
+ * Resets the size to 0 without freeing memory.
+ */
+#define vector_soa_clear(soa) do { \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_clear'", __FILE__, __LINE__); \
+        break; \
+    } \
+    (soa).size = 0; \
+} while(0)
+
+/**
+ * Shrinks every column to the current size (one realloc; frees the block when empty).
+ */
+#define vector_soa_shrink_to_fit(soa) do { \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_shrink_to_fit'", __FILE__, __LINE__); \
+        break; \
+    } \
+    if ((soa).size == (soa).capacity) break; \
+    if (private_vector_soa_realloc(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), (soa).size, \
+                                   (soa).capacity, (soa).size, (soa).allocator) == 0) \
+        (soa).capacity = (soa).size; \
+} while(0)
+
+/**
+ * Appends every element of a `vector(type)` as rows, filling one column at a time.
+ */
+#define vector_soa_from_vector(soa, vec) do { \
+    (void)sizeof((soa).row == (vec).data);      /* row types must match */ \
+    if (UNLIKELY(!vector_is_valid(soa) || !vector_is_valid(vec))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_from_vector'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = (vec).size; \
+    if (private_vector_soa_grow(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), (soa).size, \
+                                &(soa).capacity, (soa).size + _n, (soa).allocator, 1) != 0) { \
+        private_vector_fail("[x] Error: allocation failed in 'vector_soa_from_vector'", __FILE__, __LINE__); \
+        break; \
+    } \
+    for (size_t _k = 0; _k < private_vector_soa_ncols(soa); _k++) \
+        private_vector_soa_copy_field(private_vector_soa_col(&(soa).col, _k) + (soa).size * (soa).fields[_k].size, \
+                                      (soa).fields[_k].size, \
+                                      (const char *)(vec).data + (soa).fields[_k].offset, sizeof(*(vec).data), \
+                                      (soa).fields[_k].size, _n); \
+    (soa).size += _n; \
+} while(0)
+
+/**
+ * Appends every row to a `vector(type)` (one growth of `out`, one column at a time).
+ * Fields of the row type that are not columns are zeroed.
+ */
+#define vector_soa_to_vector(soa, out) do { \
+    (void)sizeof((soa).row == (out).data);      /* row types must match */ \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before 'vector_soa_to_vector'", __FILE__, __LINE__); \
+        break; \
+    } \
+    size_t _n = (soa).size; \
+    TYPE_OF((out).data) _dst = vector_append_uninit(out, _n); \
+    if (_dst == NULL_PTR || _n == 0) break; \
+    memset((void *)_dst, 0, _n * sizeof(*(out).data)); \
+    for (size_t _k = 0; _k < private_vector_soa_ncols(soa); _k++) \
+        private_vector_soa_copy_field((char *)_dst + (soa).fields[_k].offset, sizeof(*(out).data), \
+                                      private_vector_soa_col(&(soa).col, _k), (soa).fields[_k].size, \
+                                      (soa).fields[_k].size, _n); \
+} while(0)
+
+/**
+ * Frees the column block and marks the vector destroyed.
+ */
+#define vector_soa_destroy(soa) do { \
+    if (private_vector_has_magic(soa, VECTOR_MAGIC_DESTROYED)) { \
+        private_vector_fail("[x] Error: vector already destroyed", __FILE__, __LINE__); \
+        break; \
+    } \
+    if (UNLIKELY(!vector_is_valid(soa))) { \
+        private_vector_fail("[x] Error: vector not initialized before destroy", __FILE__, __LINE__); \
+        break; \
+    } \
+    private_vector_soa_realloc(&(soa).col, (soa).fields, private_vector_soa_ncols(soa), 0, \
+                               (soa).capacity, 0, (soa).allocator); \
+    (soa).size     = 0; \
+    (soa).capacity = 0; \
+    private_vector_set_magic(soa, VECTOR_MAGIC_DESTROYED); \
+} while(0)
+
+#endif /* VECTOR_SOA_H */
@@ -0,0 +1,154 @@
+/*
+    Randomized test of vector_chunked.h against a plain vector(int).
+    Small leaves and fanout force deep trees, splits, merges and root collapses.
+
+    cc -std=gnu11 -Iinclude src/test_chunked.c -o test_chunked && ./test_chunked
+*/
+#define VECTOR_CHUNKED_LEAF_BYTES 96
+#define VECTOR_CHUNKED_FANOUT     4
+#include "vector_chunked.h"
+
+#include <assert.h>
+
+typedef vector_chunked(int) ChunkedInt;
+typedef vector(int) VectorInt;
+
+static unsigned long long rng_state = 88172645463325252ull;
+
+static unsigned rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned)rng_state;
+}
+
+/* Checks the counts of every inner node against the leaves below it; returns the element count. */
+static size_t check_node(const VectorChunkedBase *cv, const void *node, size_t height)
+{
+    if (height == 0) {
+        const VectorChunkLeaf *leaf = (const VectorChunkLeaf *)node;
+        assert(leaf->size > 0 && leaf->size <= cv->leaf_capacity);
+        return leaf->size;
+    }
+    const VectorChunkInner *inner = (const VectorChunkInner *)node;
+    assert(inner->children > 0 && inner->children <= VECTOR_CHUNKED_FANOUT);
+    size_t total = 0;
+    for (size_t c = 0; c < inner->children; c++) {
+        size_t n = check_node(cv, inner->child[c], height - 1);
+        assert(n == inner->counts[c]);
+        total += n;
+    }
+    return total;
+}
+
+static void check(ChunkedInt *cv, const VectorInt *ref)
+{
+    assert(vector_chunked_size(*cv) == ref->size);
+    if (cv->root != NULL)
+        assert(check_node((const VectorChunkedBase *)cv, cv->root, cv->height) == ref->size);
+    else
+        assert(ref->size == 0 && cv->first == NULL && cv->last == NULL);
+
+    size_t k = 0;
+    vector_chunked_foreach(*cv, it) {
+        assert(*it == ref->data[k]);
+        k++;
+    }
+    assert(k == ref->size);
+
+    /* break and continue leave / skip exactly as in a flat loop */
+    if (ref->size != 0) {
+        size_t stop = rng() % ref->size, seen = 0, even = 0, expect = 0;
+        vector_chunked_foreach(*cv, it) {
+            if (seen == stop) break;
+            seen++;
+            if (*it & 1) continue;
+            even++;
+        }
+        for (size_t i = 0; i < stop; i++) expect += !(ref->data[i] & 1);
+        assert(seen == stop && even == expect);
+    }
+
+    for (int t = 0; t < 20 && ref->size != 0; t++) {
+        size_t i = rng() % ref->size;
+        assert(*vector_chunked_at(*cv, i) == ref->data[i]);
+    }
+
+    VectorInt flat;
+    memset(&flat, 0, sizeof flat);
+    vector_init(flat);
+    vector_chunked_flatten(*cv, flat);
+    assert(flat.size == ref->size);
+    assert(flat.size == 0 || memcmp(flat.data, ref->data, flat.size * sizeof(int)) == 0);
+    vector_destroy(flat);
+}
+
+int main(void)
+{
+    ChunkedInt cv;
+    VectorInt  ref;
+    memset(&cv, 0, sizeof cv);
+    memset(&ref, 0, sizeof ref);
+    vector_chunked_init(cv);
+    vector_init(ref);
+
+    for (int round = 0; round < 40000; round++) {
+        unsigned op = rng() % 10;
+        int value = (int)rng();
+        if (op < 4) {
+            size_t pos = rng() % (ref.size + 1);
+            vector_chunked_insert(cv, pos, value);
+            vector_insert(ref, pos, value);
+        } else if (op < 6) {
+            vector_chunked_push_back(cv, value);
+            vector_push_back(ref, value);
+        } else if (op < 9 && ref.size != 0) {
+            size_t pos = rng() % ref.size;
+            vector_chunked_erase(cv, pos);
+            vector_erase(ref, pos);
+        } else if (ref.size != 0) {
+            vector_chunked_pop_back(cv);
+            vector_pop_back(ref);
+        }
+        if (round % 997 == 0) check(&cv, &ref);
+
+        if (round == 20000) {
+            /* drain to empty by random erases, then grow again */
+            while (ref.size != 0) {
+                size_t pos = rng() % ref.size;
+                vector_chunked_erase(cv, pos);
+                vector_erase(ref, pos);
+            }
+            check(&cv, &ref);
+        }
+    }
+    check(&cv, &ref);
+
+    int block[300];
+    for (int i = 0; i < 300; i++) block[i] = -i;
+    vector_chunked_insert_range(cv, cv.size / 2, block, 300);
+    vector_insert_range(ref, ref.size / 2, block, 300);
+    check(&cv, &ref);
+
+#ifndef VECTOR_UNCHECKED
+    /* out-of-bounds lookups report and return NULL */
+    assert(vector_chunked_at(cv, cv.size) == NULL);
+#endif
+
+    vector_chunked_clear(cv);
+    vector_clear(ref);
+    check(&cv, &ref);
+
+    /* sequential appends fill every leaf but the last */
+    for (int i = 0; i < 1000; i++) vector_chunked_push_back(cv, i);
+    size_t leaves = 0;
+    for (VectorChunkLeaf *l = cv.first; l != NULL; l = l->next) leaves++;
+    assert(leaves == (1000 + cv.leaf_capacity - 1) / cv.leaf_capacity);
+
+    vector_chunked_destroy(cv);
+    vector_destroy(ref);
+    printf("vector_chunked: ok\n");
+    return 0;
+}
+// output -> vector_chunked: ok
@@ -0,0 +1,133 @@
+/*
+    Test of vector_cow.h: sharing, detaching on growth from either side,
+    pop-then-push and reserve below the size on a shared vector,
+    vector_unshare as sole owner, and the last reference freeing the block.
+    A counting base allocator checks that every block is freed exactly once.
+
+    cc -std=gnu11 -Iinclude src/test_cow.c -o test_cow && ./test_cow
+*/
+#include "vector_cow.h"
+
+#include <assert.h>
+
+typedef vector(int) VectorInt;
+
+static long live_blocks;
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)ctx; (void)old_size;
+    void *p = realloc(ptr, new_size);
+    if (p != NULL && ptr == NULL) live_blocks++;
+    return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx; (void)size;
+    if (ptr != NULL) live_blocks--;
+    free(ptr);
+}
+
+static const VectorAllocator counting = { counting_realloc, counting_free, NULL, NULL };
+
+static void fill(VectorInt *v, const VectorCowAllocator *cow, int n)
+{
+    memset(v, 0, sizeof *v);
+    vector_init_with_allocator(*v, &cow->allocator);
+    for (int i = 0; i < n; i++) vector_push_back(*v, i);
+}
+
+static void expect_range(const VectorInt *v, int n)
+{
+    assert(v->size == (size_t)n);
+    for (int i = 0; i < n; i++) assert(v->data[i] == i);
+}
+
+int main(void)
+{
+    VectorCowAllocator cow;
+    vector_cow_init(&cow, &counting);
+
+    /* share, then push on each side: the first pusher copies, the last owner grows in place */
+    VectorInt a, b;
+    fill(&a, &cow, 100);
+    memset(&b, 0, sizeof b);
+    vector_share(b, a);
+    assert(a.data == b.data && vector_share_count(a) == 2 && vector_is_shared(b));
+    assert(a.capacity == 0 && b.capacity == 0 && live_blocks == 1);
+
+    vector_push_back(a, 100);
+    assert(a.data != b.data && live_blocks == 2);
+    assert(vector_share_count(a) == 1 && vector_share_count(b) == 1);
+    expect_range(&a, 101);
+    expect_range(&b, 100);
+
+    vector_push_back(b, 100);                   /* sole owner: realloc, no new block */
+    assert(live_blocks == 2);
+    expect_range(&b, 101);
+    vector_destroy(a);
+    vector_destroy(b);
+    assert(live_blocks == 0);
+
+    /* pop, then push on a shared vector: the other side keeps its last element */
+    fill(&a, &cow, 50);
+    memset(&b, 0, sizeof b);
+    vector_share(b, a);
+    vector_pop_back(b);
+    vector_pop_back(b);
+    vector_push_back(b, -1);
+    expect_range(&a, 50);
+    assert(b.size == 49 && b.data[47] == 47 && b.data[48] == -1);
+    vector_destroy(a);
+    vector_destroy(b);
+    assert(live_blocks == 0);
+
+    /* reserve below the size on a shared vector keeps every element */
+    fill(&a, &cow, 100);
+    memset(&b, 0, sizeof b);
+    vector_share(b, a);
+    vector_reserve(b, 10);
+    assert(b.capacity >= 100 && b.data != a.data);
+    expect_range(&a, 100);
+    expect_range(&b, 100);
+    vector_destroy(b);
+
+    /* unshare as sole owner: O(1), same buffer, capacity back */
+    memset(&b, 0, sizeof b);
+    vector_share(b, a);
+    vector_destroy(b);
+    assert(vector_share_count(a) == 1 && a.capacity == 0);
+    int *before = a.data;
+    assert(vector_unshare(a) == 0);
+    assert(a.data == before && a.capacity >= 100 && live_blocks == 1);
+    a.data[0] = 7;                              /* in-place write is now safe */
+    a.data[0] = 0;
+    expect_range(&a, 100);
+
+    /* unshare while shared: one private copy, the other side untouched */
+    memset(&b, 0, sizeof b);
+    vector_share(b, a);
+    assert(vector_unshare(b) == 0 && b.data != a.data && live_blocks == 2);
+    b.data[0] = -5;
+    assert(a.data[0] == 0);
+
+    /* last reference frees the block, whichever vector holds it */
+    VectorInt c, d;
+    memset(&c, 0, sizeof c);
+    memset(&d, 0, sizeof d);
+    vector_share(c, a);
+    vector_share(d, c);
+    assert(vector_share_count(a) == 3);
+    vector_destroy(a);
+    vector_destroy(c);
+    assert(live_blocks == 2 && vector_share_count(d) == 1);
+    expect_range(&d, 100);
+    vector_destroy(d);
+    vector_destroy(b);
+    assert(live_blocks == 0);
+
+    printf("vector_cow: ok\n");
+    return 0;
+}
+// output -> vector_cow: ok
@@ -0,0 +1,208 @@
+/*
+    Test of vector_deque.h: random pushes and pops at both ends against a
+    plain vector(int), both segment moves of a wrapped grow, both linearize
+    paths (copy, and in place when the copy cannot be allocated), and a
+    two-thread producer/consumer run through vector_spsc.
+
+    cc -std=gnu11 -Iinclude src/test_deque.c -o test_deque -lpthread && ./test_deque
+*/
+#include "vector_deque.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+typedef vector_deque(int) DequeInt;
+typedef vector(int) VectorInt;
+
+static unsigned rng_state = 12345;
+
+static unsigned rng(void)
+{
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+/* Allocator whose fresh allocations fail on request: linearize must fall back to rotating in place. */
+static int refuse_new;
+
+static void *refusing_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)ctx; (void)old_size;
+    if (ptr == NULL && refuse_new) return NULL;
+    return realloc(ptr, new_size);
+}
+
+static void refusing_free(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx; (void)size;
+    free(ptr);
+}
+
+static const VectorAllocator refusing = { refusing_realloc, refusing_free, NULL, NULL };
+
+static void check(DequeInt *dq, const VectorInt *ref)
+{
+    assert(vector_deque_size(*dq) == ref->size);
+    for (size_t i = 0; i < ref->size; i++) assert(vector_deque_at(*dq, i) == ref->data[i]);
+}
+
+/* Builds a full, wrapped ring of 8: `head` elements popped from the front, then refilled at the back. */
+static void make_wrapped(DequeInt *dq, VectorInt *ref, size_t head)
+{
+    vector_deque_clear(*dq);
+    vector_clear(*ref);
+    for (int i = 0; i < 8; i++) { vector_deque_push_back(*dq, i); vector_push_back(*ref, i); }
+    for (size_t i = 0; i < head; i++) { vector_deque_pop_front(*dq); vector_erase(*ref, 0); }
+    for (size_t i = 0; i < head; i++) { vector_deque_push_back(*dq, 100 + (int)i); vector_push_back(*ref, 100 + (int)i); }
+    assert(dq->capacity == 8 && dq->size == 8 && dq->head == head);
+    check(dq, ref);
+}
+
+static void test_grow_and_linearize(void)
+{
+    DequeInt  dq;
+    VectorInt ref;
+    memset(&dq, 0, sizeof dq);
+    memset(&ref, 0, sizeof ref);
+    vector_deque_init_with_allocator(dq, &refusing);
+    vector_init(ref);
+
+    /* [2, 8) then [0, 2): the short front segment moves behind the old end */
+    make_wrapped(&dq, &ref, 2);
+    vector_deque_push_back(dq, -1);
+    vector_push_back(ref, -1);
+    assert(dq.capacity == 16 && dq.head == 2);
+    check(&dq, &ref);
+
+    /* [6, 8) then [0, 6): the short tail segment moves to the end of the new ring */
+    vector_deque_destroy(dq);
+    memset(&dq, 0, sizeof dq);
+    vector_deque_init_with_allocator(dq, &refusing);
+    make_wrapped(&dq, &ref, 6);
+    vector_deque_push_front(dq, -2);
+    vector_insert(ref, 0, -2);
+    assert(dq.capacity == 16 && dq.head == 16 - 2 - 1);
+    check(&dq, &ref);
+
+    /* linearize: copy into a new buffer */
+    vector_deque_destroy(dq);
+    memset(&dq, 0, sizeof dq);
+    vector_deque_init_with_allocator(dq, &refusing);
+    make_wrapped(&dq, &ref, 5);
+    int *first = vector_deque_linearize(dq);
+    assert(first == dq.data && dq.head == 0);
+    assert(memcmp(first, ref.data, ref.size * sizeof(int)) == 0);
+    check(&dq, &ref);
+
+    /* linearize: no memory for a copy, rotate in place */
+    make_wrapped(&dq, &ref, 3);
+    int *before = dq.data;
+    refuse_new = 1;
+    first = vector_deque_linearize(dq);
+    refuse_new = 0;
+    assert(first == before && dq.head == 0);
+    assert(memcmp(first, ref.data, ref.size * sizeof(int)) == 0);
+    check(&dq, &ref);
+
+    /* already contiguous: pointer to the first element, no move */
+    vector_deque_pop_front(dq);
+    vector_erase(ref, 0);
+    first = vector_deque_linearize(dq);
+    assert(first == dq.data + 1 && memcmp(first, ref.data, ref.size * sizeof(int)) == 0);
+
+    vector_deque_destroy(dq);
+    vector_destroy(ref);
+}
+
+static void test_random(void)
+{
+    DequeInt  dq;
+    VectorInt ref;
+    memset(&dq, 0, sizeof dq);
+    memset(&ref, 0, sizeof ref);
+    vector_deque_init(dq);
+    vector_init(ref);
+
+    for (int round = 0; round < 20000; round++) {
+        unsigned op = rng() % 9;
+        int value = (int)rng();
+        if (op < 2) {
+            vector_deque_push_back(dq, value);
+            vector_push_back(ref, value);
+        } else if (op < 4) {
+            vector_deque_push_front(dq, value);
+            vector_insert(ref, 0, value);
+        } else if (op < 6 && ref.size != 0) {
+            vector_deque_pop_front(dq);
+            vector_erase(ref, 0);
+        } else if (op < 8 && ref.size != 0) {
+            vector_deque_pop_back(dq);
+            vector_pop_back(ref);
+        } else if (round % 50 == 0) {
+            int *first = vector_deque_linearize(dq);
+            assert(ref.size == 0 ? first == NULL : memcmp(first, ref.data, ref.size * sizeof(int)) == 0);
+        }
+        if (ref.size != 0) {
+            assert(vector_deque_front(dq) == ref.data[0]);
+            assert(vector_deque_back(dq) == ref.data[ref.size - 1]);
+        }
+        if (round % 257 == 0) check(&dq, &ref);
+    }
+    check(&dq, &ref);
+
+    vector_deque_destroy(dq);
+    vector_destroy(ref);
+}
+
+#define SPSC_COUNT 1000000
+
+typedef vector_spsc(unsigned) QueueU;
+
+static void *spsc_producer(void *arg)
+{
+    QueueU *q = (QueueU *)arg;
+    for (unsigned i = 0; i < SPSC_COUNT; i++)
+        while (!vector_spsc_try_push(*q, i)) sched_yield();
+    return NULL;
+}
+
+static void test_spsc(void)
+{
+    QueueU q;
+    memset(&q, 0, sizeof q);
+    vector_spsc_init(q, 60);
+    assert(vector_spsc_capacity(q) == 64);
+
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, spsc_producer, &q) == 0);
+    unsigned expect = 0, got;
+    while (expect < SPSC_COUNT) {
+        if (vector_spsc_try_pop(q, &got)) {
+            assert(got == expect);
+            expect++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    assert(vector_spsc_size(q) == 0 && !vector_spsc_try_pop(q, &got));
+
+    /* full ring refuses, one pop makes room */
+    for (unsigned i = 0; i < 64; i++) assert(vector_spsc_try_push(q, i));
+    assert(!vector_spsc_try_push(q, 64u));
+    assert(vector_spsc_try_pop(q, &got) && got == 0);
+    assert(vector_spsc_try_push(q, 64u) && vector_spsc_size(q) == 64);
+
+    vector_spsc_destroy(q);
+}
+
+int main(void)
+{
+    test_grow_and_linearize();
+    test_random();
+    test_spsc();
+    printf("vector_deque: ok\n");
+    return 0;
+}
+// output -> vector_deque: ok
@@ -0,0 +1,123 @@
+/*
+    Randomized test of vector_index.h: every lookup is compared with vector_find.
+    Small value ranges make duplicates; a weak hash makes long Robin Hood runs
+    so backward-shift deletes move many entries. A failing allocator forces the
+    stale (linear scan) fallback.
+
+    cc -std=gnu11 -Iinclude src/test_index.c -o test_index && ./test_index
+*/
+#include <stdlib.h>
+
+static int fail_alloc;
+#define VECTOR_REALLOC(ptr, new_size) (fail_alloc ? NULL : realloc((ptr), (new_size)))
+#include "vector_index.h"
+
+#include <assert.h>
+
+typedef vector(int) VectorInt;
+
+static unsigned rng_state = 7;
+
+static unsigned rng(void)
+{
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+/* Eight home slots for every value: long probe runs. */
+static uint64_t weak_hash(const void *elem, size_t elem_size)
+{
+    (void)elem_size;
+    return (uint64_t)(*(const int *)elem & 7) * 0x9E3779B97F4A7C15ull;
+}
+
+static void check(VectorInt *v, VectorIndex *ix)
+{
+    assert(ix->stale || ix->count == v->size);
+    for (size_t i = 0; i < v->size; i++)
+        assert(vector_index_find(*v, *ix, v->data[i]) == vector_find(*v, v->data[i]));
+    for (int absent = -10; absent < 0; absent++)
+        assert(vector_index_find(*v, *ix, absent) == -1);
+}
+
+static void mutate(VectorInt *v, VectorIndex *ix, int rounds, int range)
+{
+    for (int r = 0; r < rounds; r++) {
+        unsigned op = rng() % 8;
+        int value = (int)(rng() % (unsigned)range);
+        if (op < 2) {
+            vector_index_push_back(*v, *ix, value);
+        } else if (op < 4) {
+            vector_index_insert(*v, *ix, rng() % (v->size + 1), value);
+        } else if (op < 6 && v->size != 0) {
+            vector_index_erase(*v, *ix, rng() % v->size);
+        } else if (op == 6 && v->size != 0) {
+            vector_index_pop_back(*v, *ix);
+        }
+        if (r % 64 == 0) check(v, ix);
+    }
+    check(v, ix);
+}
+
+static void run(VectorIndexHash hash, int range)
+{
+    VectorInt   v;
+    VectorIndex ix;
+    memset(&v, 0, sizeof v);
+    memset(&ix, 0, sizeof ix);
+    vector_init(v);
+    for (int i = 0; i < 300; i++) vector_push_back(v, (int)(rng() % (unsigned)range));
+    vector_index_build(v, ix, hash, NULL);
+    check(&v, &ix);
+
+    mutate(&v, &ix, 6000, range);
+
+    /* duplicates: the lowest position wins after erasing the first copy */
+    vector_index_clear(v, ix);
+    for (int i = 0; i < 3; i++) vector_index_push_back(v, ix, 42);
+    assert(vector_index_find(v, ix, 42) == 0);
+    vector_index_erase(v, ix, 0);
+    assert(vector_index_find(v, ix, 42) == 0 && v.size == 2);
+    vector_index_insert(v, ix, 0, 5);
+    assert(vector_index_find(v, ix, 42) == 1 && vector_index_find(v, ix, 5) == 0);
+    mutate(&v, &ix, 2000, range);
+
+    vector_index_destroy(ix);
+    vector_destroy(v);
+}
+
+int main(void)
+{
+    run(NULL, 64);
+    run(NULL, 100000);
+    run(weak_hash, 64);
+    run(weak_hash, 100000);
+
+    /* The table cannot grow: the index goes stale, lookups scan, rebuild recovers. */
+    VectorInt   v;
+    VectorIndex ix;
+    memset(&v, 0, sizeof v);
+    memset(&ix, 0, sizeof ix);
+    vector_init(v);
+    vector_reserve(v, 4096);
+    vector_index_build(v, ix, NULL, NULL);
+    fail_alloc = 1;
+    printf("expect one index allocation error:\n");
+    fflush(stdout);
+    for (int i = 0; i < 1000 && !ix.stale; i++) vector_index_push_back(v, ix, (int)(rng() % 64));
+    assert(ix.stale);
+    mutate(&v, &ix, 500, 64);
+    fail_alloc = 0;
+    vector_index_rebuild(v, ix);
+    assert(!ix.stale);
+    check(&v, &ix);
+    mutate(&v, &ix, 500, 64);
+
+    vector_index_destroy(ix);
+    vector_destroy(v);
+    printf("vector_index: ok\n");
+    return 0;
+}
+// output -> expect one index allocation error:
+//           [x] Error: index allocation failed, falling back to linear search at include/vector_index.h:...
+//           vector_index: ok